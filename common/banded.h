@@ -0,0 +1,280 @@
+#ifndef BANDED_H
+#define BANDED_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+
+// Układy pasmowe i trójdiagonalne: wykrywanie szerokości pasma, rozkład LU
+// w pamięci pasmowej O(N (2p + q + 1)) i czasie O(N p (p + q)), algorytm
+// Thomasa dla macierzy trójdiagonalnych diagonalnie dominujących oraz jego
+// wersja równoległa dla bardzo długich układów.
+
+// Szerokość pasma: a_ij = 0 dla i - j > lower oraz j - i > upper
+struct Bandwidth {
+    size_t lower = 0;
+    size_t upper = 0;
+
+    bool tridiagonal() const { return lower <= 1 && upper <= 1; }
+
+    // Czy pamięć pasmowa (z miejscem na wypełnienie od zamian wierszy)
+    // zajmuje co najwyżej połowę macierzy gęstej
+    bool worth_banded(size_t n) const { return 2 * (2 * lower + upper + 1) <= n; }
+};
+
+inline Bandwidth matrix_bandwidth(const Matrix& A) {
+    Bandwidth bw;
+    for (size_t i = 0; i < A.rows(); ++i) {
+        const double* Ai = A.row(i);
+        for (size_t j = 0; j < A.cols(); ++j) {
+            if (Ai[j] != 0.0) {
+                if (i > j) bw.lower = std::max(bw.lower, i - j);
+                else bw.upper = std::max(bw.upper, j - i);
+            }
+        }
+    }
+    return bw;
+}
+
+// Rozkład LU z częściowym wyborem elementu głównego dla macierzy pasmowej
+// (jak LAPACK dgbtrf). Wiersz i przechowuje kolumny i - p .. i + p + q:
+// zamiana z wierszem położonym najwyżej p niżej przesuwa do wiersza
+// głównego elementy aż do kolumny i + p + q. Mnożniki L zapisywane są
+// w miejscu wyzerowanych elementów pod przekątną.
+class BandedLU {
+public:
+    BandedLU(const Matrix& A, Bandwidth bw) : n_(A.rows()), p_(bw.lower), q_(bw.upper) {
+        if (A.cols() != n_) throw std::invalid_argument("BandedLU: macierz musi być kwadratowa");
+        w_ = 2 * p_ + q_ + 1;
+        band_.assign(n_ * w_, 0.0);
+        for (size_t i = 0; i < n_; ++i) {
+            const size_t j0 = i > p_ ? i - p_ : 0, j1 = std::min(n_, i + q_ + 1);
+            for (size_t j = j0; j < j1; ++j) at(i, j) = A(i, j);
+        }
+        factor();
+    }
+
+    explicit BandedLU(const Matrix& A) : BandedLU(A, matrix_bandwidth(A)) {}
+
+    size_t size() const { return n_; }
+    bool singular() const { return !regular_; }
+    Bandwidth bandwidth() const { return {p_, q_}; }
+    const std::vector<size_t>& pivots() const { return piv_; }
+
+    void solve_in_place(std::vector<double>& b) const {
+        if (b.size() != n_) throw std::invalid_argument("BandedLU::solve: zły rozmiar prawej strony");
+        if (!regular_) throw std::runtime_error("BandedLU::solve: macierz osobliwa");
+        for (size_t k = 0; k < n_; ++k) {
+            std::swap(b[k], b[piv_[k]]);
+            const size_t i1 = std::min(n_, k + p_ + 1);
+            for (size_t i = k + 1; i < i1; ++i) b[i] -= at(i, k) * b[k];
+        }
+        for (size_t k = n_; k-- > 0;) {
+            const size_t j1 = std::min(n_, k + p_ + q_ + 1);
+            const double* Uk = &at(k, k);
+            double s = b[k];
+            for (size_t j = k + 1; j < j1; ++j) s -= Uk[j - k] * b[j];
+            b[k] = s / Uk[0];
+        }
+    }
+
+    std::vector<double> solve(std::vector<double> b) const {
+        solve_in_place(b);
+        return b;
+    }
+
+private:
+    // Kolumny wiersza i leżą w band_ od indeksu i * w_ jako i - p .. i + p + q,
+    // więc fragment wiersza od przekątnej w prawo jest ciągły
+    double& at(size_t i, size_t j) { return band_[i * w_ + j + p_ - i]; }
+    const double& at(size_t i, size_t j) const { return band_[i * w_ + j + p_ - i]; }
+
+    void factor() {
+        piv_.resize(n_);
+        for (size_t k = 0; k < n_; ++k) {
+            const size_t i1 = std::min(n_, k + p_ + 1), j1 = std::min(n_, k + p_ + q_ + 1);
+            size_t piv = k;
+            double maxVal = std::abs(at(k, k));
+            for (size_t i = k + 1; i < i1; ++i) {
+                if (std::abs(at(i, k)) > maxVal) {
+                    maxVal = std::abs(at(i, k));
+                    piv = i;
+                }
+            }
+            piv_[k] = piv;
+            if (maxVal == 0.0) {
+                regular_ = false;
+                continue;
+            }
+            if (piv != k) std::swap_ranges(&at(k, k), &at(k, k) + (j1 - k), &at(piv, k));
+            const double* Uk = &at(k, k);
+            for (size_t i = k + 1; i < i1; ++i) {
+                double* Ai = &at(i, k);
+                const double l = Ai[0] /= Uk[0];
+                axpy(Ai + 1, Uk + 1, l, j1 - k - 1);
+            }
+        }
+    }
+
+    size_t n_, p_, q_, w_ = 0;
+    std::vector<double> band_;
+    std::vector<size_t> piv_;
+    bool regular_ = true;
+};
+
+// Macierz trójdiagonalna: sub[i] = a(i, i-1) (sub[0] = 0), diag[i] = a(i, i),
+// sup[i] = a(i, i+1) (sup[n-1] = 0)
+struct Tridiagonal {
+    std::vector<double> sub, diag, sup;
+
+    size_t size() const { return diag.size(); }
+
+    static Tridiagonal from_matrix(const Matrix& A) {
+        const size_t n = A.rows();
+        Tridiagonal T{std::vector<double>(n, 0.0), std::vector<double>(n), std::vector<double>(n, 0.0)};
+        for (size_t i = 0; i < n; ++i) {
+            T.diag[i] = A(i, i);
+            if (i > 0) T.sub[i] = A(i, i - 1);
+            if (i + 1 < n) T.sup[i] = A(i, i + 1);
+        }
+        return T;
+    }
+
+    // Wierszowa dominacja przekątnej (słaba); gwarantuje, że algorytm
+    // Thomasa nie trafi na zerowy element główny i nie wzmacnia błędów
+    bool diagonally_dominant() const {
+        for (size_t i = 0; i < size(); ++i) {
+            if (std::abs(diag[i]) < std::abs(sub[i]) + std::abs(sup[i]) || diag[i] == 0.0) return false;
+        }
+        return true;
+    }
+
+    // r = b - T x
+    void residual(const std::vector<double>& x, const std::vector<double>& b, std::vector<double>& r) const {
+        const size_t n = size();
+        r.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            double s = b[i] - diag[i] * x[i];
+            if (i > 0) s -= sub[i] * x[i - 1];
+            if (i + 1 < n) s -= sup[i] * x[i + 1];
+            r[i] = s;
+        }
+    }
+};
+
+// Algorytm Thomasa (eliminacja Gaussa bez wyboru elementu głównego), O(N).
+// Prawa strona nadpisywana rozwiązaniem; false przy zerowym elemencie głównym.
+inline bool thomas_solve(const Tridiagonal& T, std::vector<double>& d) {
+    const size_t n = T.size();
+    if (n == 0) return true;
+    std::vector<double> c(n);
+    double m = T.diag[0];
+    if (m == 0.0) return false;
+    c[0] = T.sup[0] / m;
+    d[0] /= m;
+    for (size_t i = 1; i < n; ++i) {
+        m = T.diag[i] - T.sub[i] * c[i - 1];
+        if (m == 0.0) return false;
+        c[i] = T.sup[i] / m;
+        d[i] = (d[i] - T.sub[i] * d[i - 1]) / m;
+    }
+    for (size_t i = n - 1; i-- > 0;) d[i] -= c[i] * d[i + 1];
+    return true;
+}
+
+// Minimalna długość bloku w wersji równoległej; krótsze układy nie
+// odrabiają kosztu synchronizacji
+constexpr size_t TRIDIAGONAL_MIN_BLOCK = 1 << 14;
+
+// Równoległe rozwiązanie długiego układu trójdiagonalnego metodą podziału:
+// każdy wątek eliminuje swój blok tak, że każdy wiersz zależy już tylko od
+// pierwszego i ostatniego niewiadomego bloku (dwa przebiegi po bloku,
+// ok. 2x praca Thomasa). Wiersze brzegowe tworzą układ trójdiagonalny
+// rozmiaru 2 * liczba_bloków, rozwiązywany algorytmem Thomasa, a na koniec
+// wnętrza bloków liczone są równolegle. Jak Thomas wymaga dominacji
+// przekątnej; false przy zerowym elemencie głównym.
+inline bool tridiagonal_solve_parallel(const Tridiagonal& T, std::vector<double>& d, WorkStealingPool& pool) {
+    const size_t n = T.size();
+    const size_t blocks = std::min<size_t>(pool.size(), n / TRIDIAGONAL_MIN_BLOCK);
+    if (blocks < 2) return thomas_solve(T, d);
+
+    // po eliminacji: x_i + a_i x_first + c_i x_last = d_i dla wnętrza bloku,
+    // dla wiersza pierwszego a_i sprzęga z poprzednim blokiem, dla ostatniego
+    // c_i z następnym
+    std::vector<double> a(n), c(n);
+    std::vector<char> ok(blocks, 1);
+    auto begin = [&](size_t blk) { return blk * n / blocks; };
+
+    for (size_t blk = 0; blk < blocks; ++blk) {
+        pool.submit([&, blk] {
+            const size_t s = begin(blk), e = begin(blk + 1);
+            for (size_t i = s; i < s + 2; ++i) {
+                if (T.diag[i] == 0.0) {
+                    ok[blk] = 0;
+                    return;
+                }
+                a[i] = T.sub[i] / T.diag[i];
+                c[i] = T.sup[i] / T.diag[i];
+                d[i] /= T.diag[i];
+            }
+            for (size_t i = s + 2; i < e; ++i) {
+                const double m = T.diag[i] - T.sub[i] * c[i - 1];
+                if (m == 0.0) {
+                    ok[blk] = 0;
+                    return;
+                }
+                d[i] = (d[i] - T.sub[i] * d[i - 1]) / m;
+                a[i] = -T.sub[i] * a[i - 1] / m;
+                c[i] = T.sup[i] / m;
+            }
+            for (size_t i = e - 2; i-- > s + 1;) {
+                d[i] -= c[i] * d[i + 1];
+                a[i] -= c[i] * a[i + 1];
+                c[i] = -c[i] * c[i + 1];
+            }
+            const double m = 1.0 - c[s] * a[s + 1];
+            if (m == 0.0) {
+                ok[blk] = 0;
+                return;
+            }
+            d[s] = (d[s] - c[s] * d[s + 1]) / m;
+            a[s] /= m;
+            c[s] = -c[s] * c[s + 1] / m;
+        });
+    }
+    pool.wait();
+    if (std::find(ok.begin(), ok.end(), 0) != ok.end()) return false;
+
+    // układ zredukowany: niewiadome x_first, x_last kolejnych bloków
+    Tridiagonal R{std::vector<double>(2 * blocks), std::vector<double>(2 * blocks, 1.0),
+                  std::vector<double>(2 * blocks)};
+    std::vector<double> y(2 * blocks);
+    for (size_t blk = 0; blk < blocks; ++blk) {
+        const size_t s = begin(blk), e = begin(blk + 1) - 1;
+        R.sub[2 * blk] = blk > 0 ? a[s] : 0.0;
+        R.sup[2 * blk] = c[s];
+        y[2 * blk] = d[s];
+        R.sub[2 * blk + 1] = a[e];
+        R.sup[2 * blk + 1] = blk + 1 < blocks ? c[e] : 0.0;
+        y[2 * blk + 1] = d[e];
+    }
+    if (!thomas_solve(R, y)) return false;
+
+    for (size_t blk = 0; blk < blocks; ++blk) {
+        pool.submit([&, blk] {
+            const size_t s = begin(blk), e = begin(blk + 1) - 1;
+            const double first = y[2 * blk], last = y[2 * blk + 1];
+            for (size_t i = s + 1; i < e; ++i) d[i] -= a[i] * first + c[i] * last;
+            d[s] = first;
+            d[e] = last;
+        });
+    }
+    pool.wait();
+    return true;
+}
+
+#endif
@@ -0,0 +1,266 @@
+#ifndef BATCHED_SOLVER_H
+#define BATCHED_SOLVER_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <immintrin.h>
+#include "matrix.h"
+#include "simd_kernels.h"
+#include "thread_pool.h"
+
+// Wiele niezależnych małych układów Ax = b tego samego rozmiaru rozwiązywanych
+// naraz. Układy są przeplatane po BATCH_LANES: element (i, j) kolejnych
+// układów grupy leży w pamięci obok siebie, więc jeden rejestr SIMD trzyma
+// ten sam element BATCH_LANES układów, a eliminacja Gaussa z częściowym
+// wyborem elementu głównego idzie dla całej grupy krok w krok, bez pętli
+// po układach i bez alokacji. Wybór elementu głównego jest bez rozgałęzień:
+// indeks wiersza głównego liczony jest porównaniami i maskami osobno dla
+// każdego układu, a zamiana wierszy to mieszanie (blend) pod maską.
+// Prawa strona jest kolumną N macierzy rozszerzonej [A | b] i po
+// rozwiązaniu zawiera x. Układy osobliwe (zerowy element główny) dostają
+// x = NaN i flagę singular().
+
+// Liczba układów w grupie: jeden rejestr AVX-512 albo dwa AVX2 liczb double
+constexpr size_t BATCH_LANES = 8;
+
+// ---- eliminacja jednej grupy; a wskazuje na [A | b] grupy, element (i, j)
+// układu l pod a[(i * (n + 1) + j) * BATCH_LANES + l]. Wersje AVX2
+// rozwiązują połowę grupy (4 układy od przesunięcia lane0), skalarna jeden
+// układ. Zwracają maskę bitową układów osobliwych. ----
+
+inline unsigned batched_eliminate_scalar(double* a, size_t n, size_t lane) {
+    const size_t w = n + 1;
+    auto at = [&](size_t i, size_t j) -> double& { return a[(i * w + j) * BATCH_LANES + lane]; };
+    bool singular = false;
+    for (size_t k = 0; k < n; ++k) {
+        size_t p = k;
+        double maxVal = std::abs(at(k, k));
+        for (size_t i = k + 1; i < n; ++i) {
+            const double v = std::abs(at(i, k));
+            p = v > maxVal ? i : p;
+            maxVal = v > maxVal ? v : maxVal;
+        }
+        singular |= !(maxVal > 0.0);
+        for (size_t j = k; j <= n; ++j) std::swap(at(k, j), at(p, j));
+        const double pivot = at(k, k) != 0.0 ? at(k, k) : 1.0;
+        for (size_t i = k + 1; i < n; ++i) {
+            const double l = at(i, k) / pivot;
+            for (size_t j = k + 1; j <= n; ++j) at(i, j) -= l * at(k, j);
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        double s = at(i, n);
+        for (size_t j = i + 1; j < n; ++j) s -= at(i, j) * at(j, n);
+        at(i, n) = s / at(i, i);
+    }
+    if (singular) {
+        for (size_t i = 0; i < n; ++i) at(i, n) = std::numeric_limits<double>::quiet_NaN();
+    }
+    return singular ? 1u : 0u;
+}
+
+__attribute__((target("avx2,fma")))
+inline unsigned batched_eliminate_avx2(double* a, size_t n, size_t lane0) {
+    const size_t w = n + 1;
+    auto at = [&](size_t i, size_t j) { return a + (i * w + j) * BATCH_LANES + lane0; };
+    const __m256d sign = _mm256_set1_pd(-0.0), zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    __m256d singular = zero;
+    for (size_t k = 0; k < n; ++k) {
+        __m256d maxVal = _mm256_andnot_pd(sign, _mm256_load_pd(at(k, k)));
+        __m256d p = _mm256_set1_pd(static_cast<double>(k));
+        for (size_t i = k + 1; i < n; ++i) {
+            const __m256d v = _mm256_andnot_pd(sign, _mm256_load_pd(at(i, k)));
+            const __m256d gt = _mm256_cmp_pd(v, maxVal, _CMP_GT_OQ);
+            maxVal = _mm256_blendv_pd(maxVal, v, gt);
+            p = _mm256_blendv_pd(p, _mm256_set1_pd(static_cast<double>(i)), gt);
+        }
+        // zero albo NaN
+        singular = _mm256_or_pd(singular, _mm256_cmp_pd(maxVal, zero, _CMP_NGT_UQ));
+        for (size_t i = k + 1; i < n; ++i) {
+            const __m256d m = _mm256_cmp_pd(p, _mm256_set1_pd(static_cast<double>(i)), _CMP_EQ_OQ);
+            double *rk = at(k, 0), *ri = at(i, 0);
+            for (size_t j = k; j <= n; ++j) {
+                const __m256d vk = _mm256_load_pd(rk + j * BATCH_LANES), vi = _mm256_load_pd(ri + j * BATCH_LANES);
+                _mm256_store_pd(rk + j * BATCH_LANES, _mm256_blendv_pd(vk, vi, m));
+                _mm256_store_pd(ri + j * BATCH_LANES, _mm256_blendv_pd(vi, vk, m));
+            }
+        }
+        __m256d pivot = _mm256_load_pd(at(k, k));
+        pivot = _mm256_blendv_pd(pivot, one, _mm256_cmp_pd(pivot, zero, _CMP_EQ_OQ));
+        const double* rk = at(k, 0);
+        for (size_t i = k + 1; i < n; ++i) {
+            double* ri = at(i, 0);
+            const __m256d l = _mm256_div_pd(_mm256_load_pd(ri + k * BATCH_LANES), pivot);
+            for (size_t j = k + 1; j <= n; ++j) {
+                const __m256d v = _mm256_fnmadd_pd(l, _mm256_load_pd(rk + j * BATCH_LANES),
+                                                   _mm256_load_pd(ri + j * BATCH_LANES));
+                _mm256_store_pd(ri + j * BATCH_LANES, v);
+            }
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        const double* ri = at(i, 0);
+        __m256d s = _mm256_load_pd(at(i, n));
+        for (size_t j = i + 1; j < n; ++j) s = _mm256_fnmadd_pd(_mm256_load_pd(ri + j * BATCH_LANES),
+                                                               _mm256_load_pd(at(j, n)), s);
+        _mm256_store_pd(at(i, n), _mm256_div_pd(s, _mm256_load_pd(ri + i * BATCH_LANES)));
+    }
+    const __m256d nan = _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN());
+    for (size_t i = 0; i < n; ++i) _mm256_store_pd(at(i, n), _mm256_blendv_pd(_mm256_load_pd(at(i, n)), nan, singular));
+    return static_cast<unsigned>(_mm256_movemask_pd(singular));
+}
+
+__attribute__((target("avx512f")))
+inline unsigned batched_eliminate_avx512(double* a, size_t n) {
+    const size_t w = n + 1;
+    auto at = [&](size_t i, size_t j) { return a + (i * w + j) * BATCH_LANES; };
+    const __m512d zero = _mm512_setzero_pd(), one = _mm512_set1_pd(1.0);
+    __mmask8 singular = 0;
+    for (size_t k = 0; k < n; ++k) {
+        __m512d maxVal = _mm512_abs_pd(_mm512_load_pd(at(k, k)));
+        __m512d p = _mm512_set1_pd(static_cast<double>(k));
+        for (size_t i = k + 1; i < n; ++i) {
+            const __m512d v = _mm512_abs_pd(_mm512_load_pd(at(i, k)));
+            const __mmask8 gt = _mm512_cmp_pd_mask(v, maxVal, _CMP_GT_OQ);
+            maxVal = _mm512_mask_blend_pd(gt, maxVal, v);
+            p = _mm512_mask_blend_pd(gt, p, _mm512_set1_pd(static_cast<double>(i)));
+        }
+        // zero albo NaN
+        singular |= _mm512_cmp_pd_mask(maxVal, zero, _CMP_NGT_UQ);
+        for (size_t i = k + 1; i < n; ++i) {
+            const __mmask8 m = _mm512_cmp_pd_mask(p, _mm512_set1_pd(static_cast<double>(i)), _CMP_EQ_OQ);
+            double *rk = at(k, 0), *ri = at(i, 0);
+            for (size_t j = k; j <= n; ++j) {
+                const __m512d vk = _mm512_load_pd(rk + j * BATCH_LANES), vi = _mm512_load_pd(ri + j * BATCH_LANES);
+                _mm512_store_pd(rk + j * BATCH_LANES, _mm512_mask_blend_pd(m, vk, vi));
+                _mm512_store_pd(ri + j * BATCH_LANES, _mm512_mask_blend_pd(m, vi, vk));
+            }
+        }
+        __m512d pivot = _mm512_load_pd(at(k, k));
+        pivot = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(pivot, zero, _CMP_EQ_OQ), pivot, one);
+        const double* rk = at(k, 0);
+        for (size_t i = k + 1; i < n; ++i) {
+            double* ri = at(i, 0);
+            const __m512d l = _mm512_div_pd(_mm512_load_pd(ri + k * BATCH_LANES), pivot);
+            for (size_t j = k + 1; j <= n; ++j) {
+                const __m512d v = _mm512_fnmadd_pd(l, _mm512_load_pd(rk + j * BATCH_LANES),
+                                                   _mm512_load_pd(ri + j * BATCH_LANES));
+                _mm512_store_pd(ri + j * BATCH_LANES, v);
+            }
+        }
+    }
+    for (size_t i = n; i-- > 0;) {
+        const double* ri = at(i, 0);
+        __m512d s = _mm512_load_pd(at(i, n));
+        for (size_t j = i + 1; j < n; ++j) s = _mm512_fnmadd_pd(_mm512_load_pd(ri + j * BATCH_LANES),
+                                                               _mm512_load_pd(at(j, n)), s);
+        _mm512_store_pd(at(i, n), _mm512_div_pd(s, _mm512_load_pd(ri + i * BATCH_LANES)));
+    }
+    const __m512d nan = _mm512_set1_pd(std::numeric_limits<double>::quiet_NaN());
+    for (size_t i = 0; i < n; ++i) _mm512_store_pd(at(i, n), _mm512_mask_blend_pd(singular, _mm512_load_pd(at(i, n)), nan));
+    return singular;
+}
+
+inline unsigned batched_eliminate(double* a, size_t n, int level) {
+    switch (level) {
+        case 2: return batched_eliminate_avx512(a, n);
+        case 1: return batched_eliminate_avx2(a, n, 0) | batched_eliminate_avx2(a, n, 4) << 4;
+        default: {
+            unsigned mask = 0;
+            for (size_t l = 0; l < BATCH_LANES; ++l) mask |= batched_eliminate_scalar(a, n, l) << l;
+            return mask;
+        }
+    }
+}
+
+// Minimalna praca (liczba grup razy N^3) jednego zadania puli, żeby
+// zadanie trwało dłużej niż jego zlecenie; poza tym zadań jest ok. 4 razy
+// więcej niż wątków
+constexpr size_t BATCH_MIN_WORK = 1 << 16;
+
+// Zbiór count układów rozmiaru n x n. Uzupełnienie ostatniej grupy to układy
+// jednostkowe, więc nie są osobliwe i nie psują masek.
+class BatchedSystems {
+public:
+    BatchedSystems(size_t n, size_t count)
+        : n_(n), count_(count), groups_((count + BATCH_LANES - 1) / BATCH_LANES),
+          data_(groups_ * n, (n + 1) * BATCH_LANES), singular_(count, 0) {
+        if (n == 0) throw std::invalid_argument("BatchedSystems: rozmiar układu musi być dodatni");
+        for (size_t s = count_; s < groups_ * BATCH_LANES; ++s) {
+            for (size_t i = 0; i < n_; ++i) element(s, i, i) = 1.0;
+        }
+    }
+
+    size_t size() const { return n_; }
+    size_t count() const { return count_; }
+
+    double& a(size_t s, size_t i, size_t j) { return element(s, i, j); }
+    double a(size_t s, size_t i, size_t j) const { return element(s, i, j); }
+    // Prawa strona przed solve(), rozwiązanie po
+    double& b(size_t s, size_t i) { return element(s, i, n_); }
+    double b(size_t s, size_t i) const { return element(s, i, n_); }
+    double x(size_t s, size_t i) const { return element(s, i, n_); }
+
+    void set_system(size_t s, const Matrix& A, const std::vector<double>& b) {
+        if (A.rows() != n_ || A.cols() != n_ || b.size() != n_) {
+            throw std::invalid_argument("BatchedSystems::set_system: niezgodne wymiary");
+        }
+        for (size_t i = 0; i < n_; ++i) {
+            for (size_t j = 0; j < n_; ++j) element(s, i, j) = A(i, j);
+            element(s, i, n_) = b[i];
+        }
+    }
+
+    std::vector<double> solution(size_t s) const {
+        std::vector<double> x(n_);
+        for (size_t i = 0; i < n_; ++i) x[i] = element(s, i, n_);
+        return x;
+    }
+
+    bool singular(size_t s) const { return singular_[s] != 0; }
+
+    // Eliminacja wszystkich układów (A nadpisywana przez U); zwraca liczbę
+    // układów osobliwych. Z pulą grupy dzielone są między wątki.
+    size_t solve(WorkStealingPool* pool = nullptr) {
+        const int level = simd_kernel_level();
+        size_t chunk = groups_;
+        if (pool) {
+            const size_t min_groups = BATCH_MIN_WORK / (n_ * n_ * n_) + 1;
+            chunk = std::max(min_groups, (groups_ + 4 * pool->size() - 1) / (4 * pool->size()));
+        }
+        for (size_t g0 = 0; g0 < groups_; g0 += chunk) {
+            const size_t g1 = std::min(groups_, g0 + chunk);
+            auto task = [this, level, g0, g1] {
+                for (size_t g = g0; g < g1; ++g) {
+                    const unsigned mask = batched_eliminate(group(g), n_, level);
+                    for (size_t l = 0; l < BATCH_LANES && g * BATCH_LANES + l < count_; ++l) {
+                        singular_[g * BATCH_LANES + l] = (mask >> l) & 1u;
+                    }
+                }
+            };
+            if (pool) pool->submit(task);
+            else task();
+        }
+        if (pool) pool->wait();
+        return static_cast<size_t>(std::count(singular_.begin(), singular_.end(), 1));
+    }
+
+private:
+    // Grupa g zajmuje n kolejnych wierszy data_, po (n + 1) * BATCH_LANES liczb
+    double* group(size_t g) { return data_.view().row(g * n_); }
+    double& element(size_t s, size_t i, size_t j) {
+        return data_.view().row((s / BATCH_LANES) * n_ + i)[j * BATCH_LANES + s % BATCH_LANES];
+    }
+    double element(size_t s, size_t i, size_t j) const {
+        return data_((s / BATCH_LANES) * n_ + i, j * BATCH_LANES + s % BATCH_LANES);
+    }
+
+    size_t n_, count_, groups_;
+    Matrix data_;
+    std::vector<char> singular_;
+};
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef CHOLESKY_H
+#define CHOLESKY_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "simd_kernels.h"
+
+// Układy symetryczne: rozkład Cholesky'ego A = L L^T (połowa operacji i
+// odczytów pamięci LU) oraz rozkład L D L^T z symetrycznym wyborem elementu
+// głównego Buncha-Kaufmana dla macierzy nieokreślonych, w pamięci upakowanej
+// (n(n+1)/2 liczb zamiast n^2).
+
+constexpr size_t CHOLESKY_BLOCK = 64;
+constexpr size_t CHOLESKY_UPDATE_COLS = 256;
+
+inline bool is_symmetric(const Matrix& A) {
+    if (A.rows() != A.cols()) return false;
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < i; ++j) {
+            if (A(i, j) != A(j, i)) return false;
+        }
+    }
+    return true;
+}
+
+// Blokowy rozkład Cholesky'ego w miejscu (wariant prawostronny). Czyta
+// i nadpisuje tylko dolny trójkąt z przekątną, górny trójkąt zostaje
+// nietknięty. A to pamięć fizyczna (MatrixView), więc dla Matrix po
+// swap_rows trzeba najpierw wywołać apply_permutation().
+// Zwraca false, gdy macierz nie jest (numerycznie) dodatnio określona;
+// wtedy przekątna i dolny trójkąt są częściowo nadpisane.
+inline bool cholesky_factor_inplace(MatrixView A, size_t block = CHOLESKY_BLOCK) {
+    const size_t n = A.rows;
+    if (A.cols != n) throw std::invalid_argument("cholesky_factor_inplace: macierz musi być kwadratowa");
+    if (block == 0) block = CHOLESKY_BLOCK;
+    std::vector<double> col, W, D;
+
+    for (size_t k0 = 0; k0 < n; k0 += block) {
+        const size_t k1 = std::min(n, k0 + block);
+
+        // panel A[k0:n, k0:k1] algorytmem nieblokowym
+        for (size_t k = k0; k < k1; ++k) {
+            const double d = A(k, k);
+            if (!(d > 0.0) || !std::isfinite(d)) return false;
+            const double l = std::sqrt(d);
+            A(k, k) = l;
+            col.resize(k1 - k - 1);
+            for (size_t i = k + 1; i < n; ++i) A(i, k) /= l;
+            for (size_t j = k + 1; j < k1; ++j) col[j - k - 1] = A(j, k);
+            for (size_t i = k + 1; i < n; ++i) {
+                const size_t len = std::min(i + 1, k1) - (k + 1);
+                axpy(A.row(i) + k + 1, col.data(), A(i, k), len);
+            }
+        }
+        if (k1 == n) break;
+
+        // A22 -= L21 L21^T, tylko dolny trójkąt. W = L21^T (nb x m) w ciągłym
+        // buforze. Blok przekątny liczony jest w całości w buforze D
+        // i przepisywany tylko do przekątnej (górny trójkąt A zostaje),
+        // części pod nim aktualizowane wprost jądrem rank_k_update.
+        const size_t nb = k1 - k0, m = n - k1;
+        W.resize(nb * m);
+        for (size_t j = 0; j < m; ++j) {
+            for (size_t t = 0; t < nb; ++t) W[t * m + j] = A(k1 + j, k0 + t);
+        }
+        for (size_t j0 = k1; j0 < n; j0 += CHOLESKY_UPDATE_COLS) {
+            const size_t j1 = std::min(n, j0 + CHOLESKY_UPDATE_COLS), w = j1 - j0;
+            D.assign(w * w, 0.0);
+            rank_k_update(w, w, nb, A.row(j0) + k0, A.ld, W.data() + (j0 - k1), m, D.data(), w);
+            for (size_t i = 0; i < w; ++i) {
+                double* Ai = A.row(j0 + i) + j0;
+                for (size_t j = 0; j <= i; ++j) Ai[j] += D[i * w + j];
+            }
+            if (j1 < n) {
+                rank_k_update(n - j1, j1 - j0, nb, A.row(j1) + k0, A.ld, W.data() + (j0 - k1), m,
+                              A.row(j1) + j0, A.ld);
+            }
+        }
+    }
+    return true;
+}
+
+// Rozwiązanie L L^T x = b czynnikiem z cholesky_factor_inplace; b nadpisywane
+inline void cholesky_solve_in_place(MatrixView L, std::vector<double>& b) {
+    const size_t n = L.rows;
+    for (size_t i = 0; i < n; ++i) {
+        const double* Li = L.row(i);
+        double s = b[i];
+        for (size_t j = 0; j < i; ++j) s -= Li[j] * b[j];
+        b[i] = s / Li[i];
+    }
+    // L^T x = y wierszami L: po wyznaczeniu x_i odejmujemy jego wkład
+    for (size_t i = n; i-- > 0;) {
+        const double* Li = L.row(i);
+        b[i] /= Li[i];
+        const double xi = b[i];
+        for (size_t j = 0; j < i; ++j) b[j] -= Li[j] * xi;
+    }
+}
+
+// Rozkład P A P^T = L D L^T, D blokowo-przekątna z blokami 1x1 i 2x2
+// (Bunch-Kaufman, jak LAPACK dsptrf z uplo = 'L'). Dolny trójkąt trzymany
+// wierszami w pamięci upakowanej: element (i, j), j <= i, pod indeksem
+// i(i+1)/2 + j, więc wiersze są ciągłe. Kodowanie ipiv jak w LAPACK:
+// ipiv[k] >= 0 - blok 1x1, wiersz k zamieniony z ipiv[k]; ipiv[k] = ipiv[k+1]
+// = -(p+1) - blok 2x2 w k, k+1, wiersz k+1 zamieniony z p.
+class LDLTFactorization {
+public:
+    // packed: dolny trójkąt A w układzie opisanym wyżej
+    LDLTFactorization(std::vector<double> packed, size_t n) : n_(n), ap_(std::move(packed)) {
+        if (ap_.size() != n * (n + 1) / 2) throw std::invalid_argument("LDLTFactorization: zły rozmiar pamięci upakowanej");
+        factor();
+    }
+
+    explicit LDLTFactorization(const Matrix& A) : LDLTFactorization(pack_lower(A), A.rows()) {}
+
+    static std::vector<double> pack_lower(const Matrix& A) {
+        if (A.rows() != A.cols()) throw std::invalid_argument("LDLTFactorization: macierz musi być kwadratowa");
+        std::vector<double> p;
+        p.reserve(A.rows() * (A.rows() + 1) / 2);
+        for (size_t i = 0; i < A.rows(); ++i) p.insert(p.end(), A.row(i), A.row(i) + i + 1);
+        return p;
+    }
+
+    size_t size() const { return n_; }
+    bool singular() const { return !regular_; }
+    const std::vector<long>& pivots() const { return ipiv_; }
+
+    // Liczba bloków 2x2 w D (0 dla macierzy dodatnio określonej
+    // z dominującą przekątną)
+    size_t two_by_two_blocks() const {
+        size_t c = 0;
+        for (size_t k = 0; k < n_; ++k) c += ipiv_[k] < 0;
+        return c / 2;
+    }
+
+    void solve_in_place(std::vector<double>& b) const {
+        if (b.size() != n_) throw std::invalid_argument("LDLTFactorization::solve: zły rozmiar prawej strony");
+        if (!regular_) throw std::runtime_error("LDLTFactorization::solve: macierz osobliwa");
+        // L D y = P b
+        for (size_t k = 0; k < n_;) {
+            if (ipiv_[k] >= 0) {
+                std::swap(b[k], b[ipiv_[k]]);
+                for (size_t i = k + 1; i < n_; ++i) b[i] -= a(i, k) * b[k];
+                b[k] /= a(k, k);
+                k += 1;
+            } else {
+                std::swap(b[k + 1], b[-ipiv_[k] - 1]);
+                for (size_t i = k + 2; i < n_; ++i) b[i] -= a(i, k) * b[k] + a(i, k + 1) * b[k + 1];
+                const double d21 = a(k + 1, k);
+                const double d11 = a(k + 1, k + 1) / d21, d22 = a(k, k) / d21;
+                const double denom = d11 * d22 - 1.0;
+                const double bk = b[k] / d21, bk1 = b[k + 1] / d21;
+                b[k] = (d11 * bk - bk1) / denom;
+                b[k + 1] = (d22 * bk1 - bk) / denom;
+                k += 2;
+            }
+        }
+        // L^T P x = y
+        for (size_t k = n_; k-- > 0;) {
+            double s = b[k];
+            for (size_t i = k + 1; i < n_; ++i) s -= a(i, k) * b[i];
+            b[k] = s;
+            if (ipiv_[k] >= 0) {
+                std::swap(b[k], b[ipiv_[k]]);
+            } else {
+                double t = b[k - 1];
+                for (size_t i = k + 1; i < n_; ++i) t -= a(i, k - 1) * b[i];
+                b[k - 1] = t;
+                std::swap(b[k], b[-ipiv_[k] - 1]);
+                --k;
+            }
+        }
+    }
+
+    std::vector<double> solve(std::vector<double> b) const {
+        solve_in_place(b);
+        return b;
+    }
+
+private:
+    double& a(size_t i, size_t j) { return ap_[i * (i + 1) / 2 + j]; }
+    double a(size_t i, size_t j) const { return ap_[i * (i + 1) / 2 + j]; }
+
+    // Symetryczna zamiana wierszy i kolumn kk < kp w części A[k:n, k:n]
+    void swap_symmetric(size_t k, size_t kk, size_t kp, bool two_by_two) {
+        for (size_t i = kp + 1; i < n_; ++i) std::swap(a(i, kk), a(i, kp));
+        for (size_t j = kk + 1; j < kp; ++j) std::swap(a(j, kk), a(kp, j));
+        std::swap(a(kk, kk), a(kp, kp));
+        if (two_by_two) std::swap(a(k + 1, k), a(kp, k));
+    }
+
+    void factor() {
+        const double alpha = (1.0 + std::sqrt(17.0)) / 8.0;
+        ipiv_.assign(n_, 0);
+        std::vector<double> w0, w1;
+        for (size_t k = 0; k < n_;) {
+            size_t kstep = 1, kp = k;
+            const double absakk = std::abs(a(k, k));
+            size_t imax = k;
+            double colmax = 0.0;
+            for (size_t i = k + 1; i < n_; ++i) {
+                if (std::abs(a(i, k)) > colmax) {
+                    colmax = std::abs(a(i, k));
+                    imax = i;
+                }
+            }
+            if (std::max(absakk, colmax) == 0.0 || !std::isfinite(absakk + colmax)) {
+                regular_ = false;
+                ipiv_[k] = static_cast<long>(k);
+                k += 1;
+                continue;
+            }
+            if (absakk < alpha * colmax) {
+                // największy element poza przekątną w wierszu/kolumnie imax
+                double rowmax = 0.0;
+                for (size_t j = k; j < imax; ++j) rowmax = std::max(rowmax, std::abs(a(imax, j)));
+                for (size_t i = imax + 1; i < n_; ++i) rowmax = std::max(rowmax, std::abs(a(i, imax)));
+                if (absakk * rowmax >= alpha * colmax * colmax) {
+                    kp = k;
+                } else if (std::abs(a(imax, imax)) >= alpha * rowmax) {
+                    kp = imax;
+                } else {
+                    kp = imax;
+                    kstep = 2;
+                }
+            }
+            const size_t kk = k + kstep - 1;
+            if (kp != kk) swap_symmetric(k, kk, kp, kstep == 2);
+
+            if (kstep == 1) {
+                // A22 -= l l^T / d, potem l /= d; wiersze A22 są ciągłe
+                const double d = a(k, k);
+                w0.resize(n_);
+                for (size_t i = k + 1; i < n_; ++i) w0[i] = a(i, k);
+                for (size_t i = k + 1; i < n_; ++i) {
+                    axpy(&a(i, k + 1), w0.data() + k + 1, w0[i] / d, i - k);
+                    a(i, k) = w0[i] / d;
+                }
+                ipiv_[k] = static_cast<long>(kp);
+            } else {
+                // blok 2x2 D = [a(k,k) a(k+1,k); a(k+1,k) a(k+1,k+1)]:
+                // W = A21 D^{-1}, A22 -= W A21^T
+                const double d21 = a(k + 1, k);
+                const double d11 = a(k + 1, k + 1) / d21, d22 = a(k, k) / d21;
+                const double t = 1.0 / (d11 * d22 - 1.0);
+                const double s = t / d21;
+                w0.resize(n_);
+                w1.resize(n_);
+                for (size_t j = k + 2; j < n_; ++j) {
+                    w0[j] = s * (d11 * a(j, k) - a(j, k + 1));
+                    w1[j] = s * (d22 * a(j, k + 1) - a(j, k));
+                }
+                for (size_t i = k + 2; i < n_; ++i) {
+                    const double ai0 = a(i, k), ai1 = a(i, k + 1);
+                    axpy(&a(i, k + 2), w0.data() + k + 2, ai0, i - k - 1);
+                    axpy(&a(i, k + 2), w1.data() + k + 2, ai1, i - k - 1);
+                }
+                for (size_t j = k + 2; j < n_; ++j) {
+                    a(j, k) = w0[j];
+                    a(j, k + 1) = w1[j];
+                }
+                ipiv_[k] = ipiv_[k + 1] = -static_cast<long>(kp) - 1;
+            }
+            k += kstep;
+        }
+    }
+
+    size_t n_;
+    std::vector<double> ap_;
+    std::vector<long> ipiv_;
+    bool regular_ = true;
+};
+
+enum class SymmetricSolver { Cholesky, LDLT };
+
+inline const char* symmetric_solver_name(SymmetricSolver s) {
+    return s == SymmetricSolver::Cholesky ? "Cholesky" : "LDL^T (Bunch-Kaufman)";
+}
+
+// Rozwiązanie symetrycznego A x = b: najpierw Cholesky w miejscu, a gdy
+// macierz okaże się nieokreślona (także numerycznie, np. źle uwarunkowane
+// równania normalne), L D L^T. Rozkład Cholesky'ego nie rusza górnego
+// trójkąta, więc macierz do L D L^T odtwarzana jest z niego i z zapisanej
+// przekątnej, bez kopii A. A nadpisywana, b zastępowane rozwiązaniem;
+// runtime_error dla macierzy osobliwej.
+inline SymmetricSolver solve_symmetric_in_place(Matrix& A, std::vector<double>& b) {
+    const size_t n = A.rows();
+    if (A.cols() != n || b.size() != n) throw std::invalid_argument("solve_symmetric_in_place: złe wymiary");
+    A.apply_permutation();
+    std::vector<double> diag(n);
+    for (size_t i = 0; i < n; ++i) diag[i] = A(i, i);
+
+    if (cholesky_factor_inplace(A.view())) {
+        cholesky_solve_in_place(A.view(), b);
+        return SymmetricSolver::Cholesky;
+    }
+
+    std::vector<double> packed;
+    packed.reserve(n * (n + 1) / 2);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < i; ++j) packed.push_back(A(j, i));
+        packed.push_back(diag[i]);
+    }
+    LDLTFactorization(std::move(packed), n).solve_in_place(b);
+    return SymmetricSolver::LDLT;
+}
+
+#endif
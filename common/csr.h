@@ -0,0 +1,103 @@
+#ifndef CSR_H
+#define CSR_H
+
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include "matrix.h"
+
+// Macierz rzadka w formacie CSR (compressed sparse row): elementy wiersza i
+// to values[row_ptr[i] .. row_ptr[i+1]) w kolumnach col_idx[...], w każdym
+// wierszu posortowane rosnąco po kolumnie.
+struct CsrMatrix {
+    size_t n = 0;
+    std::vector<size_t> row_ptr{0};
+    std::vector<size_t> col_idx;
+    std::vector<double> values;
+
+    size_t nonzeros() const { return values.size(); }
+
+    // Z macierzy gęstej, pomijając elementy o |a_ij| <= drop_tol
+    static CsrMatrix from_dense(const Matrix& A, double drop_tol = 0.0) {
+        if (A.rows() != A.cols()) throw std::invalid_argument("CsrMatrix::from_dense: macierz musi być kwadratowa");
+        CsrMatrix M;
+        M.n = A.rows();
+        M.row_ptr.assign(1, 0);
+        for (size_t i = 0; i < M.n; ++i) {
+            const double* Ai = A.row(i);
+            for (size_t j = 0; j < M.n; ++j) {
+                if (std::abs(Ai[j]) > drop_tol) {
+                    M.col_idx.push_back(j);
+                    M.values.push_back(Ai[j]);
+                }
+            }
+            M.row_ptr.push_back(M.values.size());
+        }
+        return M;
+    }
+
+    // Laplasjan 2D (5-punktowy) na siatce k x k, N = k^2; typowy duży
+    // rzadki układ do testów metod iteracyjnych
+    static CsrMatrix poisson2d(size_t k) {
+        CsrMatrix M;
+        M.n = k * k;
+        M.row_ptr.assign(1, 0);
+        for (size_t r = 0; r < k; ++r) {
+            for (size_t c = 0; c < k; ++c) {
+                auto add = [&](size_t j, double v) {
+                    M.col_idx.push_back(j);
+                    M.values.push_back(v);
+                };
+                const size_t i = r * k + c;
+                if (r > 0) add(i - k, -1.0);
+                if (c > 0) add(i - 1, -1.0);
+                add(i, 4.0);
+                if (c + 1 < k) add(i + 1, -1.0);
+                if (r + 1 < k) add(i + k, -1.0);
+                M.row_ptr.push_back(M.values.size());
+            }
+        }
+        return M;
+    }
+
+    // y = A x
+    void multiply(const std::vector<double>& x, std::vector<double>& y) const {
+        y.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            double s = 0.0;
+            for (size_t p = row_ptr[i]; p < row_ptr[i + 1]; ++p) {
+                s += values[p] * x[col_idx[p]];
+            }
+            y[i] = s;
+        }
+    }
+
+    // r = b - A x
+    void residual(const std::vector<double>& x, const std::vector<double>& b, std::vector<double>& r) const {
+        r.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            double s = b[i];
+            for (size_t p = row_ptr[i]; p < row_ptr[i + 1]; ++p) {
+                s -= values[p] * x[col_idx[p]];
+            }
+            r[i] = s;
+        }
+    }
+
+    // Pozycja elementu diagonalnego w każdym wierszu; wyjątek, gdy go brak
+    std::vector<size_t> diagonal_positions() const {
+        std::vector<size_t> pos(n);
+        for (size_t i = 0; i < n; ++i) {
+            size_t p = row_ptr[i];
+            while (p < row_ptr[i + 1] && col_idx[p] < i) ++p;
+            if (p == row_ptr[i + 1] || col_idx[p] != i || values[p] == 0.0) {
+                throw std::runtime_error("CsrMatrix: zerowy element na przekątnej w wierszu " + std::to_string(i));
+            }
+            pos[i] = p;
+        }
+        return pos;
+    }
+};
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef FUNCTION_TABLE_H
+#define FUNCTION_TABLE_H
+
+#include <vector>
+#include <cmath>
+#include <functional>
+#include <algorithm>
+
+// Tablica wartości funkcji: na [a, b] funkcja zastępowana jest wielomianami
+// trzeciego stopnia na równych podprzedziałach (interpolacja w 4 punktach
+// Czebyszewa każdego podprzedziału). Liczba podprzedziałów dobierana jest tak,
+// żeby błąd bezwzględny sprawdzony na gęstej siatce punktów kontrolnych nie
+// przekraczał max_error. Obliczenie wartości w [a, b] to wyznaczenie indeksu
+// i 3 mnożenia z dodawaniem, bez wywołań funkcji bibliotecznych; poza [a, b]
+// wywoływana jest oryginalna funkcja.
+class FunctionTable {
+public:
+    FunctionTable(std::function<double(double)> f, double a, double b, double max_error,
+                  size_t max_intervals = size_t(1) << 22)
+        : f_(std::move(f)), a_(a), b_(b) {
+        size_t n = 16, previous_n = 0;
+        double previous_error = HUGE_VAL;
+        while (true) {
+            build(n);
+            error_ = measure_error();
+            // f nieskończona albo NaN w którymś punkcie: dalsze zagęszczanie
+            // nic nie da, tablica zostaje z meets_bound() == false
+            if (!std::isfinite(error_)) break;
+            // połowa zapasu na punkty spoza siatki kontrolnej
+            if (error_ <= 0.5 * max_error || n >= max_intervals) break;
+            // błąd przestaje maleć: doszliśmy do poziomu błędów zaokrągleń
+            // samej funkcji; jeśli wręcz wzrósł, wracamy do poprzedniej tablicy
+            if (error_ > 0.5 * previous_error) {
+                if (error_ > previous_error) {
+                    build(previous_n);
+                    error_ = previous_error;
+                }
+                break;
+            }
+            previous_n = n;
+            previous_error = error_;
+            // błąd interpolacji sześciennej maleje jak h^4
+            double factor = std::pow(error_ / max_error, 0.25) * 1.2;
+            n = std::min(max_intervals, std::max(n * 2, static_cast<size_t>(n * factor)));
+        }
+        meets_bound_ = error_ <= max_error;
+    }
+
+    double operator()(double x) const {
+        if (!(x >= a_ && x <= b_)) return f_(x);
+        double s = (x - a_) * inv_h_;
+        size_t i = std::min(static_cast<size_t>(s), intervals_ - 1);
+        double t = 2.0 * (s - i) - 1.0; // położenie w podprzedziale, t w [-1, 1]
+        const double* c = &coeffs_[4 * i];
+        return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+    }
+
+    bool meets_bound() const { return meets_bound_; }
+    double max_error() const { return error_; }
+    size_t intervals() const { return intervals_; }
+
+private:
+    void build(size_t n) {
+        intervals_ = n;
+        double h = (b_ - a_) / n;
+        inv_h_ = 1.0 / h;
+        coeffs_.assign(4 * n, 0.0);
+        // punkty Czebyszewa pierwszego rodzaju na [-1, 1]
+        double nodes[4], values[4];
+        for (int k = 0; k < 4; ++k) nodes[k] = std::cos(M_PI * (2 * k + 1) / 8.0);
+        for (size_t i = 0; i < n; ++i) {
+            double center = a_ + (i + 0.5) * h;
+            for (int k = 0; k < 4; ++k) values[k] = f_(center + 0.5 * h * nodes[k]);
+            // ilorazy różnicowe i przejście z postaci Newtona do potęg t
+            double d[4] = {values[0], values[1], values[2], values[3]};
+            for (int j = 1; j < 4; ++j)
+                for (int k = 3; k >= j; --k)
+                    d[k] = (d[k] - d[k - 1]) / (nodes[k] - nodes[k - j]);
+            double poly[4] = {d[3], 0.0, 0.0, 0.0};
+            for (int j = 2; j >= 0; --j) {
+                // poly <- poly * (t - nodes[j]) + d[j]
+                for (int k = 3; k >= 1; --k) poly[k] = poly[k - 1] - nodes[j] * poly[k];
+                poly[0] = d[j] - nodes[j] * poly[0];
+            }
+            std::copy(poly, poly + 4, &coeffs_[4 * i]);
+        }
+    }
+
+    // Największy błąd w 9 punktach kontrolnych na każdym podprzedziale
+    // (co h / 8, razem z końcami)
+    double measure_error() const {
+        double error = 0.0;
+        double h = (b_ - a_) / intervals_;
+        for (size_t i = 0; i < intervals_; ++i) {
+            for (int k = 0; k <= 8; ++k) {
+                double x = a_ + (i + k / 8.0) * h;
+                double diff = std::fabs((*this)(x) - f_(x));
+                if (!(diff <= error)) error = diff;
+            }
+        }
+        return error;
+    }
+
+    std::function<double(double)> f_;
+    double a_, b_;
+    double inv_h_ = 0.0;
+    size_t intervals_ = 0;
+    std::vector<double> coeffs_; // po 4 współczynniki na podprzedział
+    double error_ = 0.0;
+    bool meets_bound_ = false;
+};
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef ITERATIVE_H
+#define ITERATIVE_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <stdexcept>
+#include "csr.h"
+
+// Metody iteracyjne dla Ax = b z macierzą w CSR: Jacobi, Gauss-Seidel
+// i GMRES(m) z prawostronnym prekondycjonowaniem (Jacobi, Gauss-Seidel, ILU(0)).
+// Każda metoda zapisuje normę residuum ||b - Ax||_2 po każdej iteracji
+// (residuals[0] to norma dla x0 = 0) i czas działania. Metody stacjonarne
+// przerywają, gdy norma przestaje być skończona (rozbieżność).
+
+struct IterativeResult {
+    std::vector<double> x;
+    std::vector<double> residuals;
+    int iterations = 0;
+    bool converged = false;
+    double seconds = 0.0;
+};
+
+struct IterativeOptions {
+    int max_iterations = 100;
+    double tolerance = 1e-10;  // względna: ||r|| / ||b||
+    int restart = 30;          // m w GMRES(m)
+};
+
+inline double norm2(const std::vector<double>& v) {
+    double s = 0.0;
+    for (double e : v) s += e * e;
+    return std::sqrt(s);
+}
+
+// ---- prekondycjonowanie: z = M^{-1} r ----
+
+enum class Preconditioner { None, Jacobi, GaussSeidel, ILU0 };
+
+inline const char* preconditioner_name(Preconditioner p) {
+    switch (p) {
+        case Preconditioner::Jacobi: return "Jacobi";
+        case Preconditioner::GaussSeidel: return "GS";
+        case Preconditioner::ILU0: return "ILU(0)";
+        default: return "brak";
+    }
+}
+
+class PreconditionerOp {
+public:
+    PreconditionerOp(const CsrMatrix& A, Preconditioner type) : A_(A), type_(type) {
+        if (type_ == Preconditioner::None) return;
+        diag_ = A.diagonal_positions();
+        if (type_ == Preconditioner::ILU0) factor_ilu0();
+    }
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const {
+        const size_t n = A_.n;
+        z.resize(n);
+        switch (type_) {
+            case Preconditioner::None:
+                z = r;
+                break;
+            case Preconditioner::Jacobi:
+                for (size_t i = 0; i < n; ++i) z[i] = r[i] / A_.values[diag_[i]];
+                break;
+            case Preconditioner::GaussSeidel:
+                // M = D + L, podstawianie w przód
+                for (size_t i = 0; i < n; ++i) {
+                    double s = r[i];
+                    for (size_t p = A_.row_ptr[i]; p < diag_[i]; ++p) s -= A_.values[p] * z[A_.col_idx[p]];
+                    z[i] = s / A_.values[diag_[i]];
+                }
+                break;
+            case Preconditioner::ILU0:
+                // M = L U z rozkładu ILU(0); L z jedynkami na przekątnej
+                for (size_t i = 0; i < n; ++i) {
+                    double s = r[i];
+                    for (size_t p = A_.row_ptr[i]; p < diag_[i]; ++p) s -= ilu_[p] * z[A_.col_idx[p]];
+                    z[i] = s;
+                }
+                for (size_t i = n; i-- > 0;) {
+                    double s = z[i];
+                    for (size_t p = diag_[i] + 1; p < A_.row_ptr[i + 1]; ++p) s -= ilu_[p] * z[A_.col_idx[p]];
+                    z[i] = s / ilu_[diag_[i]];
+                }
+                break;
+        }
+    }
+
+private:
+    // Niepełny rozkład LU bez nowych niezerowych (wzorzec jak w A),
+    // wariant IKJ; ilu_ ma ten sam układ co A.values
+    void factor_ilu0() {
+        const size_t n = A_.n;
+        ilu_ = A_.values;
+        std::vector<long> where(n, -1);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t p = A_.row_ptr[i]; p < A_.row_ptr[i + 1]; ++p) where[A_.col_idx[p]] = static_cast<long>(p);
+            for (size_t p = A_.row_ptr[i]; p < diag_[i]; ++p) {
+                const size_t k = A_.col_idx[p];
+                const double l = ilu_[p] /= ilu_[diag_[k]];
+                for (size_t q = diag_[k] + 1; q < A_.row_ptr[k + 1]; ++q) {
+                    const long pos = where[A_.col_idx[q]];
+                    if (pos >= 0) ilu_[pos] -= l * ilu_[q];
+                }
+            }
+            if (ilu_[diag_[i]] == 0.0) {
+                throw std::runtime_error("ILU(0): zerowy element główny w wierszu " + std::to_string(i));
+            }
+            for (size_t p = A_.row_ptr[i]; p < A_.row_ptr[i + 1]; ++p) where[A_.col_idx[p]] = -1;
+        }
+    }
+
+    const CsrMatrix& A_;
+    Preconditioner type_;
+    std::vector<size_t> diag_;
+    std::vector<double> ilu_;
+};
+
+// ---- metody stacjonarne ----
+
+inline IterativeResult jacobi(const CsrMatrix& A, const std::vector<double>& b, const IterativeOptions& opt = {}) {
+    auto start = std::chrono::steady_clock::now();
+    const std::vector<size_t> diag = A.diagonal_positions();
+    IterativeResult res;
+    res.x.assign(A.n, 0.0);
+    const double bnorm = std::max(norm2(b), 1e-300);
+    std::vector<double> r;
+
+    // x_{k+1} = x_k + D^{-1} (b - A x_k): jedno mnożenie na iterację daje
+    // też residuum
+    A.residual(res.x, b, r);
+    res.residuals.push_back(norm2(r));
+    while (res.iterations < opt.max_iterations && res.residuals.back() / bnorm > opt.tolerance &&
+           std::isfinite(res.residuals.back())) {
+        for (size_t i = 0; i < A.n; ++i) res.x[i] += r[i] / A.values[diag[i]];
+        A.residual(res.x, b, r);
+        res.residuals.push_back(norm2(r));
+        res.iterations++;
+    }
+    res.converged = res.residuals.back() / bnorm <= opt.tolerance;
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+inline IterativeResult gauss_seidel(const CsrMatrix& A, const std::vector<double>& b, const IterativeOptions& opt = {}) {
+    auto start = std::chrono::steady_clock::now();
+    const std::vector<size_t> diag = A.diagonal_positions();
+    IterativeResult res;
+    res.x.assign(A.n, 0.0);
+    const double bnorm = std::max(norm2(b), 1e-300);
+    std::vector<double> r;
+
+    A.residual(res.x, b, r);
+    res.residuals.push_back(norm2(r));
+    while (res.iterations < opt.max_iterations && res.residuals.back() / bnorm > opt.tolerance &&
+           std::isfinite(res.residuals.back())) {
+        std::vector<double>& x = res.x;
+        for (size_t i = 0; i < A.n; ++i) {
+            double s = b[i];
+            for (size_t p = A.row_ptr[i]; p < A.row_ptr[i + 1]; ++p) {
+                if (p != diag[i]) s -= A.values[p] * x[A.col_idx[p]];
+            }
+            x[i] = s / A.values[diag[i]];
+        }
+        A.residual(res.x, b, r);
+        res.residuals.push_back(norm2(r));
+        res.iterations++;
+    }
+    res.converged = res.residuals.back() / bnorm <= opt.tolerance;
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+// ---- GMRES(m) ----
+// Prekondycjonowanie prawostronne: rozwiązujemy A M^{-1} u = b, x = M^{-1} u, więc
+// minimalizowana norma to prawdziwe residuum ||b - Ax||. Ortogonalizacja
+// zmodyfikowanym Gramem-Schmidtem, najmniejsze kwadraty obrotami Givensa.
+// Jedna iteracja to jeden krok Arnoldiego (jedno mnożenie przez A).
+inline IterativeResult gmres(const CsrMatrix& A, const std::vector<double>& b,
+                             Preconditioner prec = Preconditioner::None, const IterativeOptions& opt = {}) {
+    auto start = std::chrono::steady_clock::now();
+    const size_t n = A.n;
+    const size_t m = static_cast<size_t>(std::max(1, opt.restart));
+    PreconditionerOp M(A, prec);
+    IterativeResult res;
+    res.x.assign(n, 0.0);
+    const double bnorm = std::max(norm2(b), 1e-300);
+
+    std::vector<std::vector<double>> V(m + 1, std::vector<double>(n)), Z(m, std::vector<double>(n));
+    std::vector<std::vector<double>> H(m + 1, std::vector<double>(m, 0.0));
+    std::vector<double> cs(m), sn(m), g(m + 1), w, r;
+
+    A.residual(res.x, b, r);
+    double beta = norm2(r);
+    res.residuals.push_back(beta);
+
+    while (res.iterations < opt.max_iterations && beta / bnorm > opt.tolerance) {
+        for (size_t i = 0; i < n; ++i) V[0][i] = r[i] / beta;
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        size_t j = 0;
+        for (; j < m && res.iterations < opt.max_iterations; ++j) {
+            M.apply(V[j], Z[j]);
+            A.multiply(Z[j], w);
+            for (size_t i = 0; i <= j; ++i) {
+                double h = 0.0;
+                for (size_t t = 0; t < n; ++t) h += w[t] * V[i][t];
+                H[i][j] = h;
+                for (size_t t = 0; t < n; ++t) w[t] -= h * V[i][t];
+            }
+            H[j + 1][j] = norm2(w);
+            if (H[j + 1][j] > 0.0) {
+                for (size_t t = 0; t < n; ++t) V[j + 1][t] = w[t] / H[j + 1][j];
+            }
+
+            for (size_t i = 0; i < j; ++i) {
+                const double t = cs[i] * H[i][j] + sn[i] * H[i + 1][j];
+                H[i + 1][j] = -sn[i] * H[i][j] + cs[i] * H[i + 1][j];
+                H[i][j] = t;
+            }
+            const double d = std::hypot(H[j][j], H[j + 1][j]);
+            cs[j] = d > 0.0 ? H[j][j] / d : 1.0;
+            sn[j] = d > 0.0 ? H[j + 1][j] / d : 0.0;
+            H[j][j] = d;
+            H[j + 1][j] = 0.0;
+            g[j + 1] = -sn[j] * g[j];
+            g[j] = cs[j] * g[j];
+
+            res.iterations++;
+            res.residuals.push_back(std::abs(g[j + 1]));
+            if (std::abs(g[j + 1]) / bnorm <= opt.tolerance || H[j][j] == 0.0) {
+                ++j;
+                break;
+            }
+        }
+
+        // y = R^{-1} g, x += Z y
+        std::vector<double> y(j);
+        for (size_t i = j; i-- > 0;) {
+            double s = g[i];
+            for (size_t k = i + 1; k < j; ++k) s -= H[i][k] * y[k];
+            y[i] = H[i][i] != 0.0 ? s / H[i][i] : 0.0;
+        }
+        for (size_t i = 0; i < j; ++i) {
+            for (size_t t = 0; t < n; ++t) res.x[t] += y[i] * Z[i][t];
+        }
+
+        // nowe residuum liczone wprost, żeby nie gubić błędów zaokrągleń
+        A.residual(res.x, b, r);
+        beta = norm2(r);
+        res.residuals.back() = beta;
+        if (j == 0) break;
+    }
+    res.converged = beta / bnorm <= opt.tolerance;
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+#endif
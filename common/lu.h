@@ -0,0 +1,226 @@
+#ifndef LU_H
+#define LU_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "matrix.h"
+#include "simd_kernels.h"
+
+// Szerokość panelu w rozkładzie blokowym; 64 kolumny panelu razy 256
+// kolumn bloku aktualizacji mieszczą się w L2
+constexpr size_t LU_BLOCK = 64;
+constexpr size_t LU_UPDATE_COLS = 256;
+
+// Rozkład panelu A[k0:n, k0:k0+nb] algorytmem nieblokowym z częściowym
+// wyborem elementu głównego. Domyślnie zamieniane są całe wiersze widoku,
+// więc zamiany od razu obejmują też kolumny na lewo i na prawo od panelu;
+// przy whole_rows = false tylko kolumny panelu (resztę robi lu_update_block).
+// Zwraca false, jeśli trafiono na zerowy element główny.
+inline bool lu_factor_panel(MatrixView A, size_t k0, size_t nb, std::vector<size_t>& piv,
+                            bool whole_rows = true) {
+    const size_t n = A.rows;
+    bool regular = true;
+    for (size_t k = k0; k < k0 + nb; ++k) {
+        size_t p = k;
+        double maxVal = std::abs(A(k, k));
+        for (size_t i = k + 1; i < n; ++i) {
+            double v = std::abs(A(i, k));
+            if (v > maxVal) {
+                maxVal = v;
+                p = i;
+            }
+        }
+        piv[k] = p;
+        if (p != k) {
+            const size_t c0 = whole_rows ? 0 : k0, c1 = whole_rows ? A.cols : k0 + nb;
+            std::swap_ranges(A.row(k) + c0, A.row(k) + c1, A.row(p) + c0);
+        }
+        if (maxVal == 0.0) {
+            regular = false;
+            continue;
+        }
+
+        const double* Uk = A.row(k);
+        const double inv = 1.0 / Uk[k];
+        for (size_t i = k + 1; i < n; ++i) {
+            double* Ai = A.row(i);
+            const double l = Ai[k] *= inv;
+            // aktualizacja tylko w obrębie panelu; reszta czeka na blok
+            axpy(Ai + k + 1, Uk + k + 1, l, k0 + nb - k - 1);
+        }
+    }
+    return regular;
+}
+
+// Aktualizacja kolumn [j0, j1) po rozkładzie panelu [k0, k1):
+// U12 = L11^{-1} A12, a potem A22 -= L21 * U12 jądrem rank_k_update. Blok U12
+// (nb x 256) zostaje w cache dla wszystkich wierszy poniżej panelu.
+inline void lu_update_block(MatrixView A, size_t k0, size_t k1, size_t j0, size_t j1) {
+    const size_t n = A.rows;
+    // podstawianie w przód z jedynkową przekątną
+    for (size_t i = k0 + 1; i < k1; ++i) {
+        double* Ai = A.row(i);
+        for (size_t p = k0; p < i; ++p) {
+            axpy(Ai + j0, A.row(p) + j0, Ai[p], j1 - j0);
+        }
+    }
+    if (k1 < n) {
+        rank_k_update(n - k1, j1 - j0, k1 - k0, A.row(k1) + k0, A.ld,
+                      A.row(k0) + j0, A.ld, A.row(k1) + j0, A.ld);
+    }
+}
+
+// Blokowy, prawostronny (right-looking) rozkład PA = LU w miejscu.
+// Po powrocie pod przekątną A leży L (z jedynkami na przekątnej, które nie
+// są zapisywane), a na przekątnej i nad nią U. piv[k] to wiersz zamieniony
+// z k-tym w k-tym kroku (jak ipiv w LAPACK-u).
+inline bool lu_factor_inplace(MatrixView A, std::vector<size_t>& piv, size_t block = LU_BLOCK) {
+    const size_t n = A.rows;
+    if (A.cols != n) throw std::invalid_argument("lu_factor_inplace: macierz musi być kwadratowa");
+    piv.resize(n);
+    bool regular = true;
+
+    for (size_t k0 = 0; k0 < n; k0 += block) {
+        const size_t nb = std::min(block, n - k0);
+        const size_t c0 = k0 + nb;
+        regular &= lu_factor_panel(A, k0, nb, piv);
+        if (c0 >= n) break;
+
+        for (size_t j0 = c0; j0 < n; j0 += LU_UPDATE_COLS) {
+            lu_update_block(A, k0, c0, j0, std::min(n, j0 + LU_UPDATE_COLS));
+        }
+    }
+    return regular;
+}
+
+// Rozkład LU z częściowym wyborem elementu głównego, wykonywany raz;
+// solve() rozwiązuje dowolną liczbę prawych stron w O(N^2) każda.
+// Macierz przekazana przez wartość jest nadpisywana czynnikami, więc
+// LUFactorization lu(std::move(A)) nie alokuje dodatkowej pamięci.
+class LUFactorization {
+public:
+    explicit LUFactorization(Matrix A, size_t block = LU_BLOCK) : lu_(std::move(A)) {
+        lu_.apply_permutation();
+        regular_ = lu_factor_inplace(lu_.view(), piv_, block);
+    }
+
+    // Opakowanie czynników policzonych gdzie indziej (np. lu_factor_tiled)
+    static LUFactorization from_factors(Matrix factors, std::vector<size_t> piv, bool regular) {
+        LUFactorization lu;
+        lu.lu_ = std::move(factors);
+        lu.piv_ = std::move(piv);
+        lu.regular_ = regular;
+        return lu;
+    }
+
+    size_t size() const { return lu_.rows(); }
+    bool singular() const { return !regular_; }
+
+    // Czynniki L i U zapisane razem w jednej macierzy
+    const Matrix& factors() const { return lu_; }
+    const std::vector<size_t>& pivots() const { return piv_; }
+
+    // perm[i] = wiersz oryginalnej macierzy, który trafił na pozycję i
+    std::vector<size_t> permutation() const {
+        std::vector<size_t> perm(size());
+        for (size_t i = 0; i < perm.size(); ++i) perm[i] = i;
+        for (size_t k = 0; k < piv_.size(); ++k) std::swap(perm[k], perm[piv_[k]]);
+        return perm;
+    }
+
+    Matrix lower() const {
+        const size_t n = size();
+        Matrix L(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(lu_.row(i), lu_.row(i) + i, L.row(i));
+            L(i, i) = 1.0;
+        }
+        return L;
+    }
+
+    Matrix upper() const {
+        const size_t n = size();
+        Matrix U(n, n);
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(lu_.row(i) + i, lu_.row(i) + n, U.row(i) + i);
+        }
+        return U;
+    }
+
+    void solve_in_place(std::vector<double>& b) const {
+        check(b.size());
+        const size_t n = size();
+        for (size_t k = 0; k < n; ++k) std::swap(b[k], b[piv_[k]]);
+        for (size_t i = 1; i < n; ++i) {
+            const double* Li = lu_.row(i);
+            double s = b[i];
+            for (size_t j = 0; j < i; ++j) s -= Li[j] * b[j];
+            b[i] = s;
+        }
+        for (size_t i = n; i-- > 0;) {
+            const double* Ui = lu_.row(i);
+            double s = b[i];
+            for (size_t j = i + 1; j < n; ++j) s -= Ui[j] * b[j];
+            b[i] = s / Ui[i];
+        }
+    }
+
+    std::vector<double> solve(std::vector<double> b) const {
+        solve_in_place(b);
+        return b;
+    }
+
+    // Wiele prawych stron naraz: kolumny B. Operacje idą całymi wierszami B,
+    // więc pętla wewnętrzna jest ciągła w pamięci.
+    void solve_in_place(Matrix& B) const {
+        check(B.rows());
+        const size_t n = size(), m = B.cols();
+        for (size_t k = 0; k < n; ++k) {
+            if (piv_[k] != k) B.swap_rows(k, piv_[k]);
+        }
+        for (size_t i = 1; i < n; ++i) {
+            const double* Li = lu_.row(i);
+            double* Bi = B.row(i);
+            for (size_t p = 0; p < i; ++p) {
+                const double l = Li[p];
+                if (l == 0.0) continue;
+                const double* Bp = B.row(p);
+                for (size_t j = 0; j < m; ++j) Bi[j] -= l * Bp[j];
+            }
+        }
+        for (size_t i = n; i-- > 0;) {
+            const double* Ui = lu_.row(i);
+            double* Bi = B.row(i);
+            for (size_t p = i + 1; p < n; ++p) {
+                const double u = Ui[p];
+                if (u == 0.0) continue;
+                const double* Bp = B.row(p);
+                for (size_t j = 0; j < m; ++j) Bi[j] -= u * Bp[j];
+            }
+            const double inv = 1.0 / Ui[i];
+            for (size_t j = 0; j < m; ++j) Bi[j] *= inv;
+        }
+        B.apply_permutation();
+    }
+
+    Matrix solve(Matrix B) const {
+        solve_in_place(B);
+        return B;
+    }
+
+private:
+    LUFactorization() = default;
+
+    void check(size_t rows) const {
+        if (rows != size()) throw std::invalid_argument("LUFactorization::solve: zły rozmiar prawej strony");
+        if (!regular_) throw std::runtime_error("LUFactorization::solve: macierz osobliwa");
+    }
+
+    Matrix lu_;
+    std::vector<size_t> piv_;
+    bool regular_ = true;
+};
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <numeric>
+#include <new>
+
+// Widok na fragment macierzy przechowywanej wierszami: element (i, j) leży
+// pod data[i * ld + j]. Nie jest właścicielem pamięci.
+struct MatrixView {
+    double* data;
+    size_t rows, cols, ld;
+
+    double& operator()(size_t i, size_t j) const { return data[i * ld + j]; }
+    double* row(size_t i) const { return data + i * ld; }
+    MatrixView block(size_t r0, size_t c0, size_t nr, size_t nc) const {
+        return {data + r0 * ld + c0, nr, nc, ld};
+    }
+};
+
+// Gęsta macierz w jednym ciągłym buforze, wierszami. Długość wiersza w
+// pamięci (ld) zaokrąglona jest do wielokrotności 8 liczb, więc każdy wiersz
+// zaczyna się na granicy 64 bajtów. Zamiana wierszy (swap_rows) zmienia tylko
+// wektor permutacji; row(i) i operator() widzą wiersze już po zamianach,
+// a view() pokazuje pamięć fizyczną (po apply_permutation() oba są zgodne).
+class Matrix {
+public:
+    Matrix() = default;
+
+    Matrix(size_t rows, size_t cols, double value = 0.0) {
+        resize(rows, cols, value);
+    }
+
+    Matrix(const Matrix& other) {
+        *this = other;
+    }
+
+    Matrix(Matrix&& other) noexcept {
+        swap(other);
+    }
+
+    Matrix& operator=(const Matrix& other) {
+        if (this != &other) {
+            allocate(other.rows_, other.cols_);
+            if (rows_ * ld_ > 0) std::memcpy(data_, other.data_, rows_ * ld_ * sizeof(double));
+            perm_ = other.perm_;
+        }
+        return *this;
+    }
+
+    Matrix& operator=(Matrix&& other) noexcept {
+        if (this != &other) {
+            Matrix empty;
+            swap(empty);
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~Matrix() {
+        std::free(data_);
+    }
+
+    void swap(Matrix& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(rows_, other.rows_);
+        std::swap(cols_, other.cols_);
+        std::swap(ld_, other.ld_);
+        perm_.swap(other.perm_);
+    }
+
+    // Zmiana rozmiaru; zawartość jest wypełniana wartością 'value'
+    void resize(size_t rows, size_t cols, double value = 0.0) {
+        allocate(rows, cols);
+        std::fill(data_, data_ + rows_ * ld_, value);
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t ld() const { return ld_; }
+
+    double& operator()(size_t i, size_t j) { return data_[perm_[i] * ld_ + j]; }
+    double operator()(size_t i, size_t j) const { return data_[perm_[i] * ld_ + j]; }
+    double* row(size_t i) { return data_ + perm_[i] * ld_; }
+    const double* row(size_t i) const { return data_ + perm_[i] * ld_; }
+
+    void swap_rows(size_t i, size_t j) { std::swap(perm_[i], perm_[j]); }
+    // perm()[i] = fizyczny indeks wiersza widocznego jako i-ty
+    const std::vector<size_t>& perm() const { return perm_; }
+
+    // Fizyczne przestawienie wierszy zgodnie z permutacją
+    void apply_permutation() {
+        bool identity = true;
+        for (size_t i = 0; i < rows_ && identity; ++i) identity = perm_[i] == i;
+        if (identity) return;
+        Matrix ordered(rows_, cols_);
+        for (size_t i = 0; i < rows_; ++i) std::memcpy(ordered.data_ + i * ld_, row(i), ld_ * sizeof(double));
+        swap(ordered);
+    }
+
+    MatrixView view() { return {data_, rows_, cols_, ld_}; }
+    MatrixView view(size_t r0, size_t c0, size_t nr, size_t nc) { return view().block(r0, c0, nr, nc); }
+
+private:
+    void allocate(size_t rows, size_t cols) {
+        size_t ld = (cols + 7) / 8 * 8;
+        if (rows * ld != rows_ * ld_ || !data_) {
+            std::free(data_);
+            data_ = nullptr;
+            if (rows * ld > 0) {
+                data_ = static_cast<double*>(std::aligned_alloc(64, rows * ld * sizeof(double)));
+                if (!data_) throw std::bad_alloc();
+            }
+        }
+        rows_ = rows;
+        cols_ = cols;
+        ld_ = ld;
+        perm_.resize(rows);
+        std::iota(perm_.begin(), perm_.end(), size_t(0));
+    }
+
+    double* data_ = nullptr;
+    size_t rows_ = 0, cols_ = 0, ld_ = 0;
+    std::vector<size_t> perm_;
+};
+
+#endif
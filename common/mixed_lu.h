@@ -0,0 +1,208 @@
+#ifndef MIXED_LU_H
+#define MIXED_LU_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <memory>
+#include <stdexcept>
+#include "matrix.h"
+#include "lu.h"
+#include "simd_kernels.h"
+
+// Rozkład LU w mieszanej precyzji: PA = LU liczone we float (jądra SIMD
+// o dwukrotnie większej liczbie elementów na rejestr, połowa przesyłanych
+// bajtów i połowa pamięci na czynniki), a potem iteracyjne doszlifowanie
+// rozwiązania z residuum r = b - Ax liczonym w double na oryginalnej A.
+// Kryterium stopu jak w LAPACK dsgesv: ||r|| <= sqrt(N) eps ||A|| ||x||
+// (normy maksimum), czyli dokładność zwykłego LU w double. Gdy poprawka
+// nie zmniejsza residuum co najmniej o połowę (macierz za źle uwarunkowana
+// na float), po MIXED_LU_MAX_ITERATIONS krokach albo gdy rozkład we float
+// się nie udał (osobliwość, elementy poza zakresem float), rozwiązanie
+// liczone jest rozkładem w double, tworzonym raz i używanym dalej.
+
+constexpr int MIXED_LU_MAX_ITERATIONS = 30;
+
+struct RefinementInfo {
+    int iterations = 0;           // liczba poprawek rozwiązania
+    bool fallback = false;        // rozwiązanie z rozkładu w double
+    double backward_error = 0.0;  // ||b - Ax|| / (||A|| ||x||)
+};
+
+class MixedPrecisionLU {
+public:
+    // A jest potrzebna do residuów i rozkładu zapasowego w double. Tu jest
+    // tylko pożyczana (bez kopii N^2 double), więc musi żyć dłużej niż
+    // rozkład i nie może być w tym czasie przeniesiona ani zmieniona.
+    explicit MixedPrecisionLU(const Matrix& A, size_t block = LU_BLOCK) : A_(&A) { init(block); }
+
+    // Macierz tymczasowa albo przeniesiona (std::move) przechodzi na
+    // własność rozkładu.
+    explicit MixedPrecisionLU(Matrix&& A, size_t block = LU_BLOCK)
+        : owned_(std::make_shared<const Matrix>(std::move(A))), A_(owned_.get()) {
+        init(block);
+    }
+
+    size_t size() const { return n_; }
+    bool factored_in_float() const { return float_ok_; }
+    bool has_double_factorization() const { return double_lu_.has_value(); }
+
+    RefinementInfo solve_in_place(std::vector<double>& b) {
+        if (b.size() != n_) throw std::invalid_argument("MixedPrecisionLU::solve: zły rozmiar prawej strony");
+        RefinementInfo info;
+        if (float_ok_ && !double_lu_) {
+            const double cte = std::sqrt(static_cast<double>(n_)) * std::numeric_limits<double>::epsilon() * normA_;
+            std::vector<double> x(n_), r(n_);
+            std::vector<float> w(n_);
+            for (size_t i = 0; i < n_; ++i) w[i] = static_cast<float>(b[i]);
+            solve_float(w);
+            for (size_t i = 0; i < n_; ++i) x[i] = w[i];
+
+            double rprev = std::numeric_limits<double>::infinity();
+            for (;;) {
+                const double rn = residual(x, b, r), xn = max_norm(x);
+                if (rn <= xn * cte) {
+                    info.backward_error = normA_ * xn > 0.0 ? rn / (normA_ * xn) : 0.0;
+                    b = std::move(x);
+                    return info;
+                }
+                if (!std::isfinite(rn) || rn > 0.5 * rprev || info.iterations >= MIXED_LU_MAX_ITERATIONS) break;
+                rprev = rn;
+                // poprawka z przeskalowanego residuum, żeby małe r nie
+                // wypadło poniżej zakresu float
+                for (size_t i = 0; i < n_; ++i) w[i] = static_cast<float>(r[i] / rn);
+                solve_float(w);
+                for (size_t i = 0; i < n_; ++i) x[i] += rn * w[i];
+                info.iterations++;
+            }
+        }
+
+        if (!double_lu_) double_lu_.emplace(*A_);
+        std::vector<double> original = b;
+        double_lu_->solve_in_place(b);
+        std::vector<double> r(n_);
+        const double rn = residual(b, original, r), xn = max_norm(b);
+        info.fallback = true;
+        info.backward_error = normA_ * xn > 0.0 ? rn / (normA_ * xn) : 0.0;
+        return info;
+    }
+
+    std::vector<double> solve(std::vector<double> b, RefinementInfo* info = nullptr) {
+        RefinementInfo i = solve_in_place(b);
+        if (info) *info = i;
+        return b;
+    }
+
+private:
+    void init(size_t block) {
+        n_ = A_->rows();
+        ld_ = (n_ + 15) / 16 * 16;
+        if (A_->cols() != n_) throw std::invalid_argument("MixedPrecisionLU: macierz musi być kwadratowa");
+        for (size_t i = 0; i < n_; ++i) {
+            const double* Ai = A_->row(i);
+            double s = 0.0;
+            for (size_t j = 0; j < n_; ++j) s += std::abs(Ai[j]);
+            normA_ = std::max(normA_, s);
+        }
+        float_ok_ = factor_float(block == 0 ? LU_BLOCK : block);
+        if (!float_ok_) lu_.clear();
+    }
+
+    float* row(size_t i) { return lu_.data() + i * ld_; }
+    const float* row(size_t i) const { return lu_.data() + i * ld_; }
+
+    // Ten sam blokowy rozkład co lu_factor_inplace, na floatach
+    bool factor_float(size_t block) {
+        const double fmax = std::numeric_limits<float>::max();
+        lu_.assign(n_ * ld_, 0.0f);
+        for (size_t i = 0; i < n_; ++i) {
+            for (size_t j = 0; j < n_; ++j) {
+                const double a = (*A_)(i, j);
+                if (!(std::abs(a) <= fmax)) return false;
+                row(i)[j] = static_cast<float>(a);
+            }
+        }
+        piv_.resize(n_);
+        for (size_t k0 = 0; k0 < n_; k0 += block) {
+            const size_t nb = std::min(block, n_ - k0), c0 = k0 + nb;
+            for (size_t k = k0; k < c0; ++k) {
+                size_t p = k;
+                float maxVal = std::abs(row(k)[k]);
+                for (size_t i = k + 1; i < n_; ++i) {
+                    if (std::abs(row(i)[k]) > maxVal) {
+                        maxVal = std::abs(row(i)[k]);
+                        p = i;
+                    }
+                }
+                if (!(maxVal > 0.0f) || !std::isfinite(maxVal)) return false;
+                piv_[k] = p;
+                if (p != k) std::swap_ranges(row(k), row(k) + n_, row(p));
+                const float* Uk = row(k);
+                const float inv = 1.0f / Uk[k];
+                for (size_t i = k + 1; i < n_; ++i) {
+                    float* Ai = row(i);
+                    const float l = Ai[k] *= inv;
+                    axpy_f32(Ai + k + 1, Uk + k + 1, l, c0 - k - 1);
+                }
+            }
+            for (size_t j0 = c0; j0 < n_; j0 += LU_UPDATE_COLS) {
+                const size_t j1 = std::min(n_, j0 + LU_UPDATE_COLS);
+                for (size_t i = k0 + 1; i < c0; ++i) {
+                    for (size_t p = k0; p < i; ++p) axpy_f32(row(i) + j0, row(p) + j0, row(i)[p], j1 - j0);
+                }
+                if (c0 < n_) {
+                    rank_k_update_f32(n_ - c0, j1 - j0, nb, row(c0) + k0, ld_, row(k0) + j0, ld_, row(c0) + j0, ld_);
+                }
+            }
+        }
+        for (size_t k = 0; k < n_; ++k) {
+            if (!std::isfinite(row(k)[k])) return false;
+        }
+        return true;
+    }
+
+    // Podstawienia w przód i wstecz; czynniki są zapisane wierszami, więc
+    // każdy krok to iloczyn skalarny wiersza z gotową częścią v
+    void solve_float(std::vector<float>& v) const {
+        for (size_t k = 0; k < n_; ++k) std::swap(v[k], v[piv_[k]]);
+        for (size_t i = 1; i < n_; ++i) {
+            v[i] -= dot_f32(row(i), v.data(), i);
+        }
+        for (size_t i = n_; i-- > 0;) {
+            const float* Ui = row(i);
+            v[i] = (v[i] - dot_f32(Ui + i + 1, v.data() + i + 1, n_ - i - 1)) / Ui[i];
+        }
+    }
+
+    // r = b - A x w double; zwraca ||r||
+    double residual(const std::vector<double>& x, const std::vector<double>& b, std::vector<double>& r) const {
+        double m = 0.0;
+        for (size_t i = 0; i < n_; ++i) {
+            const double* Ai = A_->row(i);
+            double s = b[i];
+            for (size_t j = 0; j < n_; ++j) s -= Ai[j] * x[j];
+            r[i] = s;
+            if (!(std::abs(s) <= m)) m = std::abs(s);  // przepuszcza NaN
+        }
+        return m;
+    }
+
+    static double max_norm(const std::vector<double>& v) {
+        double m = 0.0;
+        for (double e : v) m = std::max(m, std::abs(e));
+        return m;
+    }
+
+    std::shared_ptr<const Matrix> owned_;  // tylko gdy A przeszła na własność
+    const Matrix* A_;
+    size_t n_ = 0, ld_ = 0;
+    double normA_ = 0.0;
+    std::vector<float> lu_;
+    std::vector<size_t> piv_;
+    bool float_ok_ = false;
+    std::optional<LUFactorization> double_lu_;
+};
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef POLYNOMIAL_H
+#define POLYNOMIAL_H
+
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <utility>
+
+// Wielomian o współczynnikach rzeczywistych. Układ jest stały w całym
+// repozytorium: c[i] to współczynnik przy x^i (od wyrazu wolnego, jak
+// lab03::horner). Pliki z najwyższą potęgą na początku (lab06 dane.txt,
+// lab08) wczytuje się przez from_descending.
+//
+// Współczynniki leżą w jednym buforze wyrównanym do 64 bajtów. Operacje
+// z argumentem 'out' zapisują wynik do istniejącego obiektu i alokują tylko
+// wtedy, gdy jego pojemność jest za mała, więc w pętlach można je wywoływać
+// bez alokacji.
+class Polynomial {
+public:
+    Polynomial() = default;
+
+    explicit Polynomial(size_t num_coeffs) {
+        resize(num_coeffs);
+    }
+
+    Polynomial(std::initializer_list<double> ascending) {
+        resize(ascending.size());
+        std::copy(ascending.begin(), ascending.end(), data_);
+    }
+
+    static Polynomial from_ascending(const std::vector<double>& c) {
+        Polynomial p(c.size());
+        std::copy(c.begin(), c.end(), p.data_);
+        return p;
+    }
+
+    static Polynomial from_descending(const std::vector<double>& c) {
+        Polynomial p(c.size());
+        std::copy(c.rbegin(), c.rend(), p.data_);
+        return p;
+    }
+
+    Polynomial(const Polynomial& other) {
+        *this = other;
+    }
+
+    Polynomial(Polynomial&& other) noexcept
+        : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+        other.data_ = nullptr;
+        other.size_ = other.capacity_ = 0;
+    }
+
+    Polynomial& operator=(const Polynomial& other) {
+        if (this != &other) {
+            resize(other.size_);
+            if (size_) std::memcpy(data_, other.data_, size_ * sizeof(double));
+        }
+        return *this;
+    }
+
+    Polynomial& operator=(Polynomial&& other) noexcept {
+        if (this != &other) {
+            std::free(data_);
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = nullptr;
+            other.size_ = other.capacity_ = 0;
+        }
+        return *this;
+    }
+
+    ~Polynomial() {
+        std::free(data_);
+    }
+
+    // Liczba współczynników (stopień + 1); wielomian zerowy może mieć size() == 0
+    size_t size() const { return size_; }
+    int degree() const { return static_cast<int>(size_) - 1; }
+    double* data() { return data_; }
+    const double* data() const { return data_; }
+    double& operator[](size_t i) { return data_[i]; }
+    double operator[](size_t i) const { return data_[i]; }
+
+    std::vector<double> ascending() const { return std::vector<double>(data_, data_ + size_); }
+    std::vector<double> descending() const { return std::vector<double>(std::reverse_iterator<const double*>(data_ + size_),
+                                                                        std::reverse_iterator<const double*>(data_)); }
+
+    void reserve(size_t capacity) {
+        if (capacity <= capacity_) return;
+        size_t bytes = (capacity * sizeof(double) + 63) / 64 * 64;
+        double* fresh = static_cast<double*>(std::aligned_alloc(64, bytes));
+        if (!fresh) throw std::bad_alloc();
+        if (size_) std::memcpy(fresh, data_, size_ * sizeof(double));
+        std::free(data_);
+        data_ = fresh;
+        capacity_ = bytes / sizeof(double);
+    }
+
+    // Nowe współczynniki są zerowane
+    void resize(size_t num_coeffs) {
+        reserve(num_coeffs);
+        for (size_t i = size_; i < num_coeffs; ++i) data_[i] = 0.0;
+        size_ = num_coeffs;
+    }
+
+    // Schemat Hornera
+    double operator()(double x) const {
+        if (size_ == 0) return 0.0;
+        double result = data_[size_ - 1];
+        for (size_t i = size_ - 1; i-- > 0;) result = result * x + data_[i];
+        return result;
+    }
+
+    void derivative(Polynomial& out) const {
+        size_t n = size_ > 1 ? size_ - 1 : 0;
+        out.resize(n);
+        for (size_t i = 0; i < n; ++i) out.data_[i] = (i + 1) * data_[i + 1];
+    }
+
+    // Funkcja pierwotna o wartości 'constant' w zerze
+    void antiderivative(Polynomial& out, double constant = 0.0) const {
+        size_t n = size_;
+        out.resize(n + 1);
+        for (size_t i = n; i > 0; --i) out.data_[i] = data_[i - 1] / i;
+        out.data_[0] = constant;
+    }
+
+    Polynomial derivative() const {
+        Polynomial out;
+        derivative(out);
+        return out;
+    }
+
+    Polynomial antiderivative(double constant = 0.0) const {
+        Polynomial out;
+        antiderivative(out, constant);
+        return out;
+    }
+
+    // Dokładna całka oznaczona (Horner dla funkcji pierwotnej, bez alokacji)
+    double integrate(double a, double b) const {
+        auto primitive = [this](double x) {
+            double result = 0.0;
+            for (size_t i = size_; i > 0; --i) result = result * x + data_[i - 1] / i;
+            return result * x;
+        };
+        return primitive(b) - primitive(a);
+    }
+
+    // out = p * q; out nie może być żadnym z argumentów
+    static void multiply(const Polynomial& p, const Polynomial& q, Polynomial& out) {
+        if (p.size_ == 0 || q.size_ == 0) {
+            out.resize(0);
+            return;
+        }
+        size_t n = p.size_ + q.size_ - 1;
+        out.reserve(n);
+        out.size_ = n;
+        std::fill(out.data_, out.data_ + n, 0.0);
+        for (size_t i = 0; i < p.size_; ++i) {
+            double pi = p.data_[i];
+            for (size_t j = 0; j < q.size_; ++j) out.data_[i + j] += pi * q.data_[j];
+        }
+    }
+
+    // out = p(q(x)) schematem Hornera; scratch to bufor roboczy (też
+    // używany ponownie). out i scratch muszą być różne od p i q.
+    static void compose(const Polynomial& p, const Polynomial& q, Polynomial& out, Polynomial& scratch) {
+        out.resize(0);
+        if (p.size_ == 0) return;
+        size_t q_degree = q.size_ > 0 ? q.size_ - 1 : 0;
+        size_t max_size = (p.size_ - 1) * q_degree + 1;
+        out.reserve(max_size);
+        scratch.reserve(max_size);
+        out.resize(1);
+        out.data_[0] = p.data_[p.size_ - 1];
+        for (size_t i = p.size_ - 1; i-- > 0;) {
+            multiply(out, q, scratch);
+            if (scratch.size_ == 0) scratch.resize(1);
+            scratch.data_[0] += p.data_[i];
+            std::swap(out.data_, scratch.data_);
+            std::swap(out.size_, scratch.size_);
+            std::swap(out.capacity_, scratch.capacity_);
+        }
+    }
+
+    Polynomial operator*(const Polynomial& q) const {
+        Polynomial out;
+        multiply(*this, q, out);
+        return out;
+    }
+
+private:
+    double* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+// Wielomian o stopniu N znanym w czasie kompilacji, współczynniki jak
+// w Polynomial (c[i] przy x^i). Schemat Hornera jest w całości rozwinięty
+// przez wyrażenie fold i daje te same zaokrąglenia co Polynomial::operator().
+template <int N>
+struct FixedPolynomial {
+    double c[N + 1];
+
+    double operator()(double x) const {
+        return eval(x, std::make_integer_sequence<int, N + 1>{});
+    }
+
+private:
+    template <int... I>
+    double eval(double x, std::integer_sequence<int, I...>) const {
+        double result = 0.0;
+        ((result = result * x + c[N - I]), ...);
+        return result;
+    }
+};
+
+constexpr int MAX_FIXED_DEGREE = 16;
+
+// Wywołuje body(q) z FixedPolynomial stopnia p.degree() (do
+// MAX_FIXED_DEGREE), a dla wyższych stopni z samym p. Pozwala pisać
+// kwadratury i inne pętle jako szablony po funkcji podcałkowej tak, żeby
+// wielomian z pliku liczył się bez pętli po współczynnikach.
+template <int N = 0, typename Body>
+decltype(auto) with_polynomial(const Polynomial& p, Body&& body) {
+    if constexpr (N > MAX_FIXED_DEGREE) {
+        return body(p);
+    } else {
+        if (p.size() == N + 1) {
+            FixedPolynomial<N> q{};
+            std::copy(p.data(), p.data() + N + 1, q.c);
+            return body(q);
+        }
+        return with_polynomial<N + 1>(p, body);
+    }
+}
+
+#endif
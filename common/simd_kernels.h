@@ -0,0 +1,496 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <cstddef>
+#include <immintrin.h>
+
+// Jądra aktualizacji wierszy w eliminacji Gaussa i rozkładzie LU, w wersjach
+// skalarnej, AVX2 i AVX-512 wybieranych w czasie działania programu.
+//
+// axpy i axpy_rows liczą y - a * x osobnym mnożeniem i odejmowaniem (bez FMA),
+// więc przy zwykłej kompilacji (bez -mfma / -march=native, które pozwalają
+// kompilatorowi samemu łączyć działania) zaokrąglenia są te same co w pętli
+// skalarnej i wyniki kolejnych kroków eliminacji się nie zmieniają; te jądra
+// i tak ogranicza przepustowość pamięci, a nie arytmetyka.
+// rank_k_update jest ograniczony obliczeniami i korzysta z FMA.
+
+// 0 - skalarnie, 1 - AVX2 + FMA, 2 - AVX-512F
+inline int simd_kernel_level() {
+    static const int level = __builtin_cpu_supports("avx512f") ? 2
+                           : (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) ? 1 : 0;
+    return level;
+}
+
+inline const char* simd_kernel_name(int level) {
+    return level == 2 ? "AVX-512" : level == 1 ? "AVX2" : "skalarnie";
+}
+
+// ---- y[j] -= a * x[j], j < n ----
+
+inline void axpy_scalar(double* y, const double* x, double a, size_t n) {
+    for (size_t j = 0; j < n; ++j) {
+        y[j] -= a * x[j];
+    }
+}
+
+// Bez "fma" w target kompilator nie może skleić mnożenia z odejmowaniem
+__attribute__((target("avx2")))
+inline void axpy_avx2(double* y, const double* x, double a, size_t n) {
+    const __m256d va = _mm256_set1_pd(a);
+    size_t j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256d y0 = _mm256_loadu_pd(y + j), y1 = _mm256_loadu_pd(y + j + 4);
+        y0 = _mm256_sub_pd(y0, _mm256_mul_pd(va, _mm256_loadu_pd(x + j)));
+        y1 = _mm256_sub_pd(y1, _mm256_mul_pd(va, _mm256_loadu_pd(x + j + 4)));
+        _mm256_storeu_pd(y + j, y0);
+        _mm256_storeu_pd(y + j + 4, y1);
+    }
+    for (; j < n; ++j) {
+        y[j] -= a * x[j];
+    }
+}
+
+// AVX-512F zawiera FMA, więc mnożenie idzie przez wariant z jawnym
+// zaokrągleniem, którego kompilator nie łączy z odejmowaniem
+#define SIMD_MUL512(a, b) _mm512_maskz_mul_round_pd(0xFF, (a), (b), _MM_FROUND_CUR_DIRECTION)
+
+__attribute__((target("avx512f")))
+inline void axpy_avx512(double* y, const double* x, double a, size_t n) {
+    const __m512d va = _mm512_set1_pd(a);
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m512d y0 = _mm512_loadu_pd(y + j), y1 = _mm512_loadu_pd(y + j + 8);
+        y0 = _mm512_sub_pd(y0, SIMD_MUL512(va, _mm512_loadu_pd(x + j)));
+        y1 = _mm512_sub_pd(y1, SIMD_MUL512(va, _mm512_loadu_pd(x + j + 8)));
+        _mm512_storeu_pd(y + j, y0);
+        _mm512_storeu_pd(y + j + 8, y1);
+    }
+    for (; j < n; j += 8) {
+        const __mmask8 m = n - j >= 8 ? 0xFF : static_cast<__mmask8>((1u << (n - j)) - 1);
+        __m512d yv = _mm512_maskz_loadu_pd(m, y + j);
+        yv = _mm512_sub_pd(yv, SIMD_MUL512(va, _mm512_maskz_loadu_pd(m, x + j)));
+        _mm512_mask_storeu_pd(y + j, m, yv);
+    }
+}
+
+inline void axpy(double* y, const double* x, double a, size_t n) {
+    switch (simd_kernel_level()) {
+        case 2: axpy_avx512(y, x, a, n); break;
+        case 1: axpy_avx2(y, x, a, n); break;
+        default: axpy_scalar(y, x, a, n); break;
+    }
+}
+
+// ---- rows[r][j] -= a[r] * x[j], r < m, j < n ----
+// Wiersz x jest wczytywany raz na cztery wiersze docelowe.
+
+inline void axpy_rows_scalar(double* const* rows, const double* a, size_t m, const double* x, size_t n) {
+    for (size_t r = 0; r < m; ++r) {
+        axpy_scalar(rows[r], x, a[r], n);
+    }
+}
+
+__attribute__((target("avx2")))
+inline void axpy_rows_avx2(double* const* rows, const double* a, size_t m, const double* x, size_t n) {
+    size_t r = 0;
+    for (; r + 4 <= m; r += 4) {
+        double *y0 = rows[r], *y1 = rows[r + 1], *y2 = rows[r + 2], *y3 = rows[r + 3];
+        const __m256d a0 = _mm256_set1_pd(a[r]), a1 = _mm256_set1_pd(a[r + 1]);
+        const __m256d a2 = _mm256_set1_pd(a[r + 2]), a3 = _mm256_set1_pd(a[r + 3]);
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4) {
+            const __m256d xv = _mm256_loadu_pd(x + j);
+            _mm256_storeu_pd(y0 + j, _mm256_sub_pd(_mm256_loadu_pd(y0 + j), _mm256_mul_pd(a0, xv)));
+            _mm256_storeu_pd(y1 + j, _mm256_sub_pd(_mm256_loadu_pd(y1 + j), _mm256_mul_pd(a1, xv)));
+            _mm256_storeu_pd(y2 + j, _mm256_sub_pd(_mm256_loadu_pd(y2 + j), _mm256_mul_pd(a2, xv)));
+            _mm256_storeu_pd(y3 + j, _mm256_sub_pd(_mm256_loadu_pd(y3 + j), _mm256_mul_pd(a3, xv)));
+        }
+        for (; j < n; ++j) {
+            y0[j] -= a[r] * x[j];
+            y1[j] -= a[r + 1] * x[j];
+            y2[j] -= a[r + 2] * x[j];
+            y3[j] -= a[r + 3] * x[j];
+        }
+    }
+    for (; r < m; ++r) {
+        axpy_avx2(rows[r], x, a[r], n);
+    }
+}
+
+__attribute__((target("avx512f")))
+inline void axpy_rows_avx512(double* const* rows, const double* a, size_t m, const double* x, size_t n) {
+    size_t r = 0;
+    for (; r + 4 <= m; r += 4) {
+        double *y0 = rows[r], *y1 = rows[r + 1], *y2 = rows[r + 2], *y3 = rows[r + 3];
+        const __m512d a0 = _mm512_set1_pd(a[r]), a1 = _mm512_set1_pd(a[r + 1]);
+        const __m512d a2 = _mm512_set1_pd(a[r + 2]), a3 = _mm512_set1_pd(a[r + 3]);
+        for (size_t j = 0; j < n; j += 8) {
+            const __mmask8 m8 = n - j >= 8 ? 0xFF : static_cast<__mmask8>((1u << (n - j)) - 1);
+            const __m512d xv = _mm512_maskz_loadu_pd(m8, x + j);
+            _mm512_mask_storeu_pd(y0 + j, m8, _mm512_sub_pd(_mm512_maskz_loadu_pd(m8, y0 + j), SIMD_MUL512(a0, xv)));
+            _mm512_mask_storeu_pd(y1 + j, m8, _mm512_sub_pd(_mm512_maskz_loadu_pd(m8, y1 + j), SIMD_MUL512(a1, xv)));
+            _mm512_mask_storeu_pd(y2 + j, m8, _mm512_sub_pd(_mm512_maskz_loadu_pd(m8, y2 + j), SIMD_MUL512(a2, xv)));
+            _mm512_mask_storeu_pd(y3 + j, m8, _mm512_sub_pd(_mm512_maskz_loadu_pd(m8, y3 + j), SIMD_MUL512(a3, xv)));
+        }
+    }
+    for (; r < m; ++r) {
+        axpy_avx512(rows[r], x, a[r], n);
+    }
+}
+
+#undef SIMD_MUL512
+
+inline void axpy_rows(double* const* rows, const double* a, size_t m, const double* x, size_t n) {
+    switch (simd_kernel_level()) {
+        case 2: axpy_rows_avx512(rows, a, m, x, n); break;
+        case 1: axpy_rows_avx2(rows, a, m, x, n); break;
+        default: axpy_rows_scalar(rows, a, m, x, n); break;
+    }
+}
+
+// ---- Y -= A * U: Y (m x n, ldy), A (m x k, lda), U (k x n, ldu) ----
+// Kafelek 4 wiersze x 2 wektory zostaje w rejestrach przez całą pętlę po k.
+
+inline void rank_k_update_scalar(size_t m, size_t n, size_t k, const double* A, size_t lda,
+                                 const double* U, size_t ldu, double* Y, size_t ldy) {
+    for (size_t r = 0; r < m; ++r) {
+        for (size_t p = 0; p < k; ++p) {
+            axpy_scalar(Y + r * ldy, U + p * ldu, A[r * lda + p], n);
+        }
+    }
+}
+
+__attribute__((target("avx2,fma")))
+inline void rank_k_update_avx2(size_t m, size_t n, size_t k, const double* A, size_t lda,
+                               const double* U, size_t ldu, double* Y, size_t ldy) {
+    size_t r = 0;
+    for (; r + 4 <= m; r += 4) {
+        const double* a0 = A + r * lda;
+        const double *a1 = a0 + lda, *a2 = a1 + lda, *a3 = a2 + lda;
+        double* y0 = Y + r * ldy;
+        double *y1 = y0 + ldy, *y2 = y1 + ldy, *y3 = y2 + ldy;
+        size_t j = 0;
+        for (; j + 8 <= n; j += 8) {
+            __m256d c00 = _mm256_loadu_pd(y0 + j), c01 = _mm256_loadu_pd(y0 + j + 4);
+            __m256d c10 = _mm256_loadu_pd(y1 + j), c11 = _mm256_loadu_pd(y1 + j + 4);
+            __m256d c20 = _mm256_loadu_pd(y2 + j), c21 = _mm256_loadu_pd(y2 + j + 4);
+            __m256d c30 = _mm256_loadu_pd(y3 + j), c31 = _mm256_loadu_pd(y3 + j + 4);
+            for (size_t p = 0; p < k; ++p) {
+                const __m256d u0 = _mm256_loadu_pd(U + p * ldu + j), u1 = _mm256_loadu_pd(U + p * ldu + j + 4);
+                __m256d l = _mm256_set1_pd(a0[p]);
+                c00 = _mm256_fnmadd_pd(l, u0, c00);
+                c01 = _mm256_fnmadd_pd(l, u1, c01);
+                l = _mm256_set1_pd(a1[p]);
+                c10 = _mm256_fnmadd_pd(l, u0, c10);
+                c11 = _mm256_fnmadd_pd(l, u1, c11);
+                l = _mm256_set1_pd(a2[p]);
+                c20 = _mm256_fnmadd_pd(l, u0, c20);
+                c21 = _mm256_fnmadd_pd(l, u1, c21);
+                l = _mm256_set1_pd(a3[p]);
+                c30 = _mm256_fnmadd_pd(l, u0, c30);
+                c31 = _mm256_fnmadd_pd(l, u1, c31);
+            }
+            _mm256_storeu_pd(y0 + j, c00);
+            _mm256_storeu_pd(y0 + j + 4, c01);
+            _mm256_storeu_pd(y1 + j, c10);
+            _mm256_storeu_pd(y1 + j + 4, c11);
+            _mm256_storeu_pd(y2 + j, c20);
+            _mm256_storeu_pd(y2 + j + 4, c21);
+            _mm256_storeu_pd(y3 + j, c30);
+            _mm256_storeu_pd(y3 + j + 4, c31);
+        }
+        if (j < n) {
+            rank_k_update_scalar(4, n - j, k, a0, lda, U + j, ldu, y0 + j, ldy);
+        }
+    }
+    for (; r < m; ++r) {
+        for (size_t p = 0; p < k; ++p) {
+            axpy_avx2(Y + r * ldy, U + p * ldu, A[r * lda + p], n);
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+inline void rank_k_update_avx512(size_t m, size_t n, size_t k, const double* A, size_t lda,
+                                 const double* U, size_t ldu, double* Y, size_t ldy) {
+    size_t r = 0;
+    for (; r + 4 <= m; r += 4) {
+        const double* a0 = A + r * lda;
+        const double *a1 = a0 + lda, *a2 = a1 + lda, *a3 = a2 + lda;
+        double* y0 = Y + r * ldy;
+        double *y1 = y0 + ldy, *y2 = y1 + ldy, *y3 = y2 + ldy;
+        size_t j = 0;
+        for (; j + 16 <= n; j += 16) {
+            __m512d c00 = _mm512_loadu_pd(y0 + j), c01 = _mm512_loadu_pd(y0 + j + 8);
+            __m512d c10 = _mm512_loadu_pd(y1 + j), c11 = _mm512_loadu_pd(y1 + j + 8);
+            __m512d c20 = _mm512_loadu_pd(y2 + j), c21 = _mm512_loadu_pd(y2 + j + 8);
+            __m512d c30 = _mm512_loadu_pd(y3 + j), c31 = _mm512_loadu_pd(y3 + j + 8);
+            for (size_t p = 0; p < k; ++p) {
+                const __m512d u0 = _mm512_loadu_pd(U + p * ldu + j), u1 = _mm512_loadu_pd(U + p * ldu + j + 8);
+                __m512d l = _mm512_set1_pd(a0[p]);
+                c00 = _mm512_fnmadd_pd(l, u0, c00);
+                c01 = _mm512_fnmadd_pd(l, u1, c01);
+                l = _mm512_set1_pd(a1[p]);
+                c10 = _mm512_fnmadd_pd(l, u0, c10);
+                c11 = _mm512_fnmadd_pd(l, u1, c11);
+                l = _mm512_set1_pd(a2[p]);
+                c20 = _mm512_fnmadd_pd(l, u0, c20);
+                c21 = _mm512_fnmadd_pd(l, u1, c21);
+                l = _mm512_set1_pd(a3[p]);
+                c30 = _mm512_fnmadd_pd(l, u0, c30);
+                c31 = _mm512_fnmadd_pd(l, u1, c31);
+            }
+            _mm512_storeu_pd(y0 + j, c00);
+            _mm512_storeu_pd(y0 + j + 8, c01);
+            _mm512_storeu_pd(y1 + j, c10);
+            _mm512_storeu_pd(y1 + j + 8, c11);
+            _mm512_storeu_pd(y2 + j, c20);
+            _mm512_storeu_pd(y2 + j + 8, c21);
+            _mm512_storeu_pd(y3 + j, c30);
+            _mm512_storeu_pd(y3 + j + 8, c31);
+        }
+        if (j < n) {
+            rank_k_update_avx2(4, n - j, k, a0, lda, U + j, ldu, y0 + j, ldy);
+        }
+    }
+    if (r < m) {
+        rank_k_update_avx2(m - r, n, k, A + r * lda, lda, U, ldu, Y + r * ldy, ldy);
+    }
+}
+
+inline void rank_k_update(size_t m, size_t n, size_t k, const double* A, size_t lda,
+                          const double* U, size_t ldu, double* Y, size_t ldy) {
+    switch (simd_kernel_level()) {
+        case 2: rank_k_update_avx512(m, n, k, A, lda, U, ldu, Y, ldy); break;
+        case 1: rank_k_update_avx2(m, n, k, A, lda, U, ldu, Y, ldy); break;
+        default: rank_k_update_scalar(m, n, k, A, lda, U, ldu, Y, ldy); break;
+    }
+}
+
+// ---- wersje w pojedynczej precyzji (float): dwa razy więcej elementów na
+// rejestr i połowa przesyłanych bajtów; dla rozkładu w mieszanej precyzji.
+// Zgodność zaokrągleń z pętlą skalarną nie ma tu znaczenia (wynik i tak
+// poprawia iteracyjne doszlifowanie), więc AVX-512 używa FMA. ----
+
+inline void axpy_f32_scalar(float* y, const float* x, float a, size_t n) {
+    for (size_t j = 0; j < n; ++j) {
+        y[j] -= a * x[j];
+    }
+}
+
+__attribute__((target("avx2")))
+inline void axpy_f32_avx2(float* y, const float* x, float a, size_t n) {
+    const __m256 va = _mm256_set1_ps(a);
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m256 y0 = _mm256_loadu_ps(y + j), y1 = _mm256_loadu_ps(y + j + 8);
+        y0 = _mm256_sub_ps(y0, _mm256_mul_ps(va, _mm256_loadu_ps(x + j)));
+        y1 = _mm256_sub_ps(y1, _mm256_mul_ps(va, _mm256_loadu_ps(x + j + 8)));
+        _mm256_storeu_ps(y + j, y0);
+        _mm256_storeu_ps(y + j + 8, y1);
+    }
+    for (; j < n; ++j) {
+        y[j] -= a * x[j];
+    }
+}
+
+__attribute__((target("avx512f")))
+inline void axpy_f32_avx512(float* y, const float* x, float a, size_t n) {
+    const __m512 va = _mm512_set1_ps(a);
+    size_t j = 0;
+    for (; j + 32 <= n; j += 32) {
+        __m512 y0 = _mm512_loadu_ps(y + j), y1 = _mm512_loadu_ps(y + j + 16);
+        y0 = _mm512_fnmadd_ps(va, _mm512_loadu_ps(x + j), y0);
+        y1 = _mm512_fnmadd_ps(va, _mm512_loadu_ps(x + j + 16), y1);
+        _mm512_storeu_ps(y + j, y0);
+        _mm512_storeu_ps(y + j + 16, y1);
+    }
+    for (; j < n; j += 16) {
+        const __mmask16 m = n - j >= 16 ? 0xFFFF : static_cast<__mmask16>((1u << (n - j)) - 1);
+        __m512 yv = _mm512_maskz_loadu_ps(m, y + j);
+        yv = _mm512_fnmadd_ps(va, _mm512_maskz_loadu_ps(m, x + j), yv);
+        _mm512_mask_storeu_ps(y + j, m, yv);
+    }
+}
+
+inline void axpy_f32(float* y, const float* x, float a, size_t n) {
+    switch (simd_kernel_level()) {
+        case 2: axpy_f32_avx512(y, x, a, n); break;
+        case 1: axpy_f32_avx2(y, x, a, n); break;
+        default: axpy_f32_scalar(y, x, a, n); break;
+    }
+}
+
+// ---- iloczyn skalarny sum x[j] * y[j], j < n (float) ----
+
+inline float dot_f32_scalar(const float* x, const float* y, size_t n) {
+    float s = 0.0f;
+    for (size_t j = 0; j < n; ++j) {
+        s += x[j] * y[j];
+    }
+    return s;
+}
+
+__attribute__((target("avx2,fma")))
+inline float dot_f32_avx2(const float* x, const float* y, size_t n) {
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+    size_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + j), _mm256_loadu_ps(y + j), s0);
+        s1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + j + 8), _mm256_loadu_ps(y + j + 8), s1);
+    }
+    s0 = _mm256_add_ps(s0, s1);
+    __m128 h = _mm_add_ps(_mm256_castps256_ps128(s0), _mm256_extractf128_ps(s0, 1));
+    h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+    h = _mm_add_ss(h, _mm_shuffle_ps(h, h, 1));
+    float s = _mm_cvtss_f32(h);
+    for (; j < n; ++j) {
+        s += x[j] * y[j];
+    }
+    return s;
+}
+
+__attribute__((target("avx512f")))
+inline float dot_f32_avx512(const float* x, const float* y, size_t n) {
+    __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+    size_t j = 0;
+    for (; j + 32 <= n; j += 32) {
+        s0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + j), _mm512_loadu_ps(y + j), s0);
+        s1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + j + 16), _mm512_loadu_ps(y + j + 16), s1);
+    }
+    for (; j < n; j += 16) {
+        const __mmask16 m = n - j >= 16 ? 0xFFFF : static_cast<__mmask16>((1u << (n - j)) - 1);
+        s0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, x + j), _mm512_maskz_loadu_ps(m, y + j), s0);
+    }
+    float lanes[16];
+    _mm512_storeu_ps(lanes, _mm512_add_ps(s0, s1));
+    float s = 0.0f;
+    for (float e : lanes) s += e;
+    return s;
+}
+
+inline float dot_f32(const float* x, const float* y, size_t n) {
+    switch (simd_kernel_level()) {
+        case 2: return dot_f32_avx512(x, y, n);
+        case 1: return dot_f32_avx2(x, y, n);
+        default: return dot_f32_scalar(x, y, n);
+    }
+}
+
+inline void rank_k_update_f32_scalar(size_t m, size_t n, size_t k, const float* A, size_t lda,
+                                     const float* U, size_t ldu, float* Y, size_t ldy) {
+    for (size_t r = 0; r < m; ++r) {
+        for (size_t p = 0; p < k; ++p) {
+            axpy_f32_scalar(Y + r * ldy, U + p * ldu, A[r * lda + p], n);
+        }
+    }
+}
+
+__attribute__((target("avx2,fma")))
+inline void rank_k_update_f32_avx2(size_t m, size_t n, size_t k, const float* A, size_t lda,
+                                   const float* U, size_t ldu, float* Y, size_t ldy) {
+    size_t r = 0;
+    for (; r + 4 <= m; r += 4) {
+        const float* a0 = A + r * lda;
+        const float *a1 = a0 + lda, *a2 = a1 + lda, *a3 = a2 + lda;
+        float* y0 = Y + r * ldy;
+        float *y1 = y0 + ldy, *y2 = y1 + ldy, *y3 = y2 + ldy;
+        size_t j = 0;
+        for (; j + 16 <= n; j += 16) {
+            __m256 c00 = _mm256_loadu_ps(y0 + j), c01 = _mm256_loadu_ps(y0 + j + 8);
+            __m256 c10 = _mm256_loadu_ps(y1 + j), c11 = _mm256_loadu_ps(y1 + j + 8);
+            __m256 c20 = _mm256_loadu_ps(y2 + j), c21 = _mm256_loadu_ps(y2 + j + 8);
+            __m256 c30 = _mm256_loadu_ps(y3 + j), c31 = _mm256_loadu_ps(y3 + j + 8);
+            for (size_t p = 0; p < k; ++p) {
+                const __m256 u0 = _mm256_loadu_ps(U + p * ldu + j), u1 = _mm256_loadu_ps(U + p * ldu + j + 8);
+                __m256 l = _mm256_set1_ps(a0[p]);
+                c00 = _mm256_fnmadd_ps(l, u0, c00);
+                c01 = _mm256_fnmadd_ps(l, u1, c01);
+                l = _mm256_set1_ps(a1[p]);
+                c10 = _mm256_fnmadd_ps(l, u0, c10);
+                c11 = _mm256_fnmadd_ps(l, u1, c11);
+                l = _mm256_set1_ps(a2[p]);
+                c20 = _mm256_fnmadd_ps(l, u0, c20);
+                c21 = _mm256_fnmadd_ps(l, u1, c21);
+                l = _mm256_set1_ps(a3[p]);
+                c30 = _mm256_fnmadd_ps(l, u0, c30);
+                c31 = _mm256_fnmadd_ps(l, u1, c31);
+            }
+            _mm256_storeu_ps(y0 + j, c00);
+            _mm256_storeu_ps(y0 + j + 8, c01);
+            _mm256_storeu_ps(y1 + j, c10);
+            _mm256_storeu_ps(y1 + j + 8, c11);
+            _mm256_storeu_ps(y2 + j, c20);
+            _mm256_storeu_ps(y2 + j + 8, c21);
+            _mm256_storeu_ps(y3 + j, c30);
+            _mm256_storeu_ps(y3 + j + 8, c31);
+        }
+        if (j < n) {
+            rank_k_update_f32_scalar(4, n - j, k, a0, lda, U + j, ldu, y0 + j, ldy);
+        }
+    }
+    for (; r < m; ++r) {
+        for (size_t p = 0; p < k; ++p) {
+            axpy_f32_avx2(Y + r * ldy, U + p * ldu, A[r * lda + p], n);
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+inline void rank_k_update_f32_avx512(size_t m, size_t n, size_t k, const float* A, size_t lda,
+                                     const float* U, size_t ldu, float* Y, size_t ldy) {
+    size_t r = 0;
+    for (; r + 4 <= m; r += 4) {
+        const float* a0 = A + r * lda;
+        const float *a1 = a0 + lda, *a2 = a1 + lda, *a3 = a2 + lda;
+        float* y0 = Y + r * ldy;
+        float *y1 = y0 + ldy, *y2 = y1 + ldy, *y3 = y2 + ldy;
+        size_t j = 0;
+        for (; j + 32 <= n; j += 32) {
+            __m512 c00 = _mm512_loadu_ps(y0 + j), c01 = _mm512_loadu_ps(y0 + j + 16);
+            __m512 c10 = _mm512_loadu_ps(y1 + j), c11 = _mm512_loadu_ps(y1 + j + 16);
+            __m512 c20 = _mm512_loadu_ps(y2 + j), c21 = _mm512_loadu_ps(y2 + j + 16);
+            __m512 c30 = _mm512_loadu_ps(y3 + j), c31 = _mm512_loadu_ps(y3 + j + 16);
+            for (size_t p = 0; p < k; ++p) {
+                const __m512 u0 = _mm512_loadu_ps(U + p * ldu + j), u1 = _mm512_loadu_ps(U + p * ldu + j + 16);
+                __m512 l = _mm512_set1_ps(a0[p]);
+                c00 = _mm512_fnmadd_ps(l, u0, c00);
+                c01 = _mm512_fnmadd_ps(l, u1, c01);
+                l = _mm512_set1_ps(a1[p]);
+                c10 = _mm512_fnmadd_ps(l, u0, c10);
+                c11 = _mm512_fnmadd_ps(l, u1, c11);
+                l = _mm512_set1_ps(a2[p]);
+                c20 = _mm512_fnmadd_ps(l, u0, c20);
+                c21 = _mm512_fnmadd_ps(l, u1, c21);
+                l = _mm512_set1_ps(a3[p]);
+                c30 = _mm512_fnmadd_ps(l, u0, c30);
+                c31 = _mm512_fnmadd_ps(l, u1, c31);
+            }
+            _mm512_storeu_ps(y0 + j, c00);
+            _mm512_storeu_ps(y0 + j + 16, c01);
+            _mm512_storeu_ps(y1 + j, c10);
+            _mm512_storeu_ps(y1 + j + 16, c11);
+            _mm512_storeu_ps(y2 + j, c20);
+            _mm512_storeu_ps(y2 + j + 16, c21);
+            _mm512_storeu_ps(y3 + j, c30);
+            _mm512_storeu_ps(y3 + j + 16, c31);
+        }
+        if (j < n) {
+            rank_k_update_f32_avx2(4, n - j, k, a0, lda, U + j, ldu, y0 + j, ldy);
+        }
+    }
+    if (r < m) {
+        rank_k_update_f32_avx2(m - r, n, k, A + r * lda, lda, U, ldu, Y + r * ldy, ldy);
+    }
+}
+
+inline void rank_k_update_f32(size_t m, size_t n, size_t k, const float* A, size_t lda,
+                              const float* U, size_t ldu, float* Y, size_t ldy) {
+    switch (simd_kernel_level()) {
+        case 2: rank_k_update_f32_avx512(m, n, k, A, lda, U, ldu, Y, ldy); break;
+        case 1: rank_k_update_f32_avx2(m, n, k, A, lda, U, ldu, Y, ldy); break;
+        default: rank_k_update_f32_scalar(m, n, k, A, lda, U, ldu, Y, ldy); break;
+    }
+}
+
+#endif
@@ -0,0 +1,461 @@
+#ifndef SPARSE_LU_H
+#define SPARSE_LU_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include "csr.h"
+
+// Rozkład LU macierzy rzadkiej: P A Q = L U, gdzie Q to permutacja kolumn
+// (i wierszy) zmniejszająca wypełnienie, a P wynika z wyboru elementu
+// głównego. Pamięć i czas rosną z liczbą niezerowych L i U, nie z N^2.
+//
+// Dwie fazy:
+//   sparse_lu_analyze - uporządkowanie (RCM) i wzorzec A w CSC; zależy tylko
+//                       od wzorca, więc nadaje się do wielu macierzy o tym
+//                       samym rozkładzie niezerowych,
+//   SparseLU          - rozkład numeryczny algorytmem Gilberta-Peierlsa
+//                       (kolumnami, lewostronnie) z progowym wyborem elementu
+//                       głównego; refactor() ponownie używa wzorca L, U
+//                       i wyborów elementu głównego z poprzedniego rozkładu.
+
+enum class SparseOrdering { Natural, RCM };
+
+inline const char* sparse_ordering_name(SparseOrdering o) {
+    return o == SparseOrdering::RCM ? "RCM" : "naturalne";
+}
+
+constexpr size_t SPARSE_NONE = std::numeric_limits<size_t>::max();
+
+// Graf wzorca A + A^T bez przekątnej (listy sąsiedztwa w układzie CSR)
+inline void sparse_symmetric_graph(const CsrMatrix& A, std::vector<size_t>& adj_ptr, std::vector<size_t>& adj) {
+    const size_t n = A.n;
+    std::vector<size_t> count(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t p = A.row_ptr[i]; p < A.row_ptr[i + 1]; ++p) {
+            if (A.col_idx[p] != i) {
+                count[i + 1]++;
+                count[A.col_idx[p] + 1]++;
+            }
+        }
+    }
+    for (size_t i = 0; i < n; ++i) count[i + 1] += count[i];
+    adj.assign(count[n], 0);
+    std::vector<size_t> next(count.begin(), count.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t p = A.row_ptr[i]; p < A.row_ptr[i + 1]; ++p) {
+            const size_t j = A.col_idx[p];
+            if (j != i) {
+                adj[next[i]++] = j;
+                adj[next[j]++] = i;
+            }
+        }
+    }
+    // każda krawędź niesymetrycznego wzorca pojawia się raz, symetrycznego
+    // dwa razy - usuwamy powtórzenia
+    adj_ptr.assign(n + 1, 0);
+    size_t out = 0;
+    for (size_t i = 0; i < n; ++i) {
+        auto first = adj.begin() + count[i], last = adj.begin() + count[i + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        for (auto it = first; it != last; ++it) adj[out++] = *it;
+        adj_ptr[i + 1] = out;
+    }
+    adj.resize(out);
+}
+
+// Odwrócony algorytm Cuthilla-McKee: BFS od wierzchołka pseudo-peryferyjnego,
+// sąsiedzi w kolejności rosnącego stopnia, na końcu odwrócenie kolejności.
+// Zwraca perm, gdzie perm[k] to stary indeks k-tego wierzchołka.
+inline std::vector<size_t> rcm_ordering(const CsrMatrix& A) {
+    const size_t n = A.n;
+    std::vector<size_t> adj_ptr, adj;
+    sparse_symmetric_graph(A, adj_ptr, adj);
+    auto degree = [&](size_t v) { return adj_ptr[v + 1] - adj_ptr[v]; };
+
+    std::vector<size_t> perm;
+    perm.reserve(n);
+    std::vector<char> placed(n, 0);
+    std::vector<size_t> level(n, SPARSE_NONE), queue;
+    queue.reserve(n);
+
+    // BFS w obrębie składowej (z pominięciem już ustawionych wierzchołków);
+    // zwraca głębokość, queue zawiera odwiedzone wierzchołki poziomami,
+    // ostatni poziom zaczyna się od queue[last_start]
+    size_t last_start = 0;
+    auto bfs_levels = [&](size_t root) {
+        queue.clear();
+        queue.push_back(root);
+        level[root] = 0;
+        size_t depth = 0;
+        last_start = 0;
+        for (size_t h = 0; h < queue.size(); ++h) {
+            const size_t v = queue[h];
+            if (level[v] > depth) {
+                depth = level[v];
+                last_start = h;
+            }
+            for (size_t p = adj_ptr[v]; p < adj_ptr[v + 1]; ++p) {
+                const size_t u = adj[p];
+                if (!placed[u] && level[u] == SPARSE_NONE) {
+                    level[u] = level[v] + 1;
+                    queue.push_back(u);
+                }
+            }
+        }
+        for (size_t v : queue) level[v] = SPARSE_NONE;
+        return depth;
+    };
+
+    std::vector<size_t> by_degree(n);
+    for (size_t v = 0; v < n; ++v) by_degree[v] = v;
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](size_t a, size_t b) { return degree(a) < degree(b); });
+
+    for (size_t seed : by_degree) {
+        if (placed[seed]) continue;
+        // wierzchołek pseudo-peryferyjny (George, Liu): z ostatniego poziomu
+        // wybieramy wierzchołek o najmniejszym stopniu, dopóki głębokość rośnie
+        size_t root = seed, depth = bfs_levels(root);
+        for (;;) {
+            size_t best = queue[last_start];
+            for (size_t h = last_start + 1; h < queue.size(); ++h) {
+                if (degree(queue[h]) < degree(best)) best = queue[h];
+            }
+            const size_t d = bfs_levels(best);
+            if (d <= depth) break;
+            root = best;
+            depth = d;
+        }
+
+        const size_t start = perm.size();
+        perm.push_back(root);
+        placed[root] = 1;
+        for (size_t h = start; h < perm.size(); ++h) {
+            const size_t v = perm[h];
+            const size_t first = perm.size();
+            for (size_t p = adj_ptr[v]; p < adj_ptr[v + 1]; ++p) {
+                const size_t u = adj[p];
+                if (!placed[u]) {
+                    placed[u] = 1;
+                    perm.push_back(u);
+                }
+            }
+            std::stable_sort(perm.begin() + first, perm.end(),
+                             [&](size_t a, size_t b) { return degree(a) < degree(b); });
+        }
+    }
+    std::reverse(perm.begin(), perm.end());
+    return perm;
+}
+
+// Analiza symboliczna: permutacja q, wzorzec A w CSC (z mapą do A.values,
+// żeby kolejne macierze o tym samym wzorcu przepisywać bez sortowania)
+// i oszacowanie wypełnienia z drzewa eliminacji wzorca A + A^T.
+struct SparseSymbolic {
+    size_t n = 0;
+    SparseOrdering ordering = SparseOrdering::RCM;
+    std::vector<size_t> q;                            // kolumna k rozkładu = kolumna q[k] macierzy A
+    std::vector<size_t> col_ptr, row_idx, csr_pos;    // A w CSC; wartość = A.values[csr_pos[p]]
+    std::vector<size_t> pattern_row_ptr, pattern_col; // wzorzec A, do sprawdzenia w refactor()
+    size_t fill_estimate = 0;                         // nnz(L) Cholesky'ego dla P(A + A^T)P^T
+
+    bool matches(const CsrMatrix& A) const {
+        return A.n == n && A.row_ptr == pattern_row_ptr && A.col_idx == pattern_col;
+    }
+};
+
+inline SparseSymbolic sparse_lu_analyze(const CsrMatrix& A, SparseOrdering ordering = SparseOrdering::RCM) {
+    const size_t n = A.n;
+    SparseSymbolic S;
+    S.n = n;
+    S.ordering = ordering;
+    S.pattern_row_ptr = A.row_ptr;
+    S.pattern_col = A.col_idx;
+
+    if (ordering == SparseOrdering::RCM) {
+        S.q = rcm_ordering(A);
+    } else {
+        S.q.resize(n);
+        for (size_t k = 0; k < n; ++k) S.q[k] = k;
+    }
+
+    // transpozycja wzorca: CSR -> CSC
+    S.col_ptr.assign(n + 1, 0);
+    for (size_t j : A.col_idx) S.col_ptr[j + 1]++;
+    for (size_t j = 0; j < n; ++j) S.col_ptr[j + 1] += S.col_ptr[j];
+    S.row_idx.resize(A.nonzeros());
+    S.csr_pos.resize(A.nonzeros());
+    std::vector<size_t> next(S.col_ptr.begin(), S.col_ptr.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t p = A.row_ptr[i]; p < A.row_ptr[i + 1]; ++p) {
+            const size_t dst = next[A.col_idx[p]]++;
+            S.row_idx[dst] = i;
+            S.csr_pos[dst] = p;
+        }
+    }
+
+    // Drzewo eliminacji (z kompresją ścieżek) i liczności wierszy czynnika
+    // Cholesky'ego wzorca A + A^T po permutacji - dolne ograniczenie nnz(L)
+    // i dobre oszacowanie nnz(U) przy elementach głównych z przekątnej.
+    std::vector<size_t> adj_ptr, adj;
+    sparse_symmetric_graph(A, adj_ptr, adj);
+    std::vector<size_t> qinv(n), parent(n, SPARSE_NONE), ancestor(n, SPARSE_NONE), mark(n, SPARSE_NONE);
+    for (size_t k = 0; k < n; ++k) qinv[S.q[k]] = k;
+    for (size_t k = 0; k < n; ++k) {
+        const size_t v = S.q[k];
+        for (size_t p = adj_ptr[v]; p < adj_ptr[v + 1]; ++p) {
+            size_t i = qinv[adj[p]];
+            while (i < k && i != SPARSE_NONE) {
+                const size_t up = ancestor[i];
+                ancestor[i] = k;
+                if (up == SPARSE_NONE) parent[i] = k;
+                i = up;
+            }
+        }
+    }
+    S.fill_estimate = n;
+    for (size_t k = 0; k < n; ++k) {
+        mark[k] = k;
+        const size_t v = S.q[k];
+        for (size_t p = adj_ptr[v]; p < adj_ptr[v + 1]; ++p) {
+            // poddrzewo wiersza k: od każdego sąsiada i < k w górę drzewa
+            for (size_t i = qinv[adj[p]]; i < k && mark[i] != k; i = parent[i]) {
+                mark[i] = k;
+                S.fill_estimate++;
+            }
+        }
+    }
+    return S;
+}
+
+// Rozkład numeryczny. L jest trójkątna dolna z jedynkami na przekątnej
+// (nie przechowywanymi), U trójkątna górna z elementem diagonalnym na końcu
+// każdej kolumny; obie w CSC, indeksy wierszy już po permutacji P.
+// Element główny kolumny k: diagonalny a(q[k], q[k]), jeśli
+// |a| >= pivot_tolerance * max|kolumny|, inaczej największy co do modułu.
+// Próg 1 to zwykły częściowy wybór, mniejszy chroni uporządkowanie
+// przed wypełnieniem kosztem nieco większego wzrostu elementów.
+class SparseLU {
+public:
+    SparseLU(const CsrMatrix& A, SparseSymbolic symbolic, double pivot_tolerance = 0.1)
+        : sym_(std::move(symbolic)), tol_(pivot_tolerance) {
+        if (!sym_.matches(A)) throw std::invalid_argument("SparseLU: wzorzec macierzy niezgodny z analizą");
+        factor(A);
+    }
+
+    explicit SparseLU(const CsrMatrix& A, SparseOrdering ordering = SparseOrdering::RCM,
+                      double pivot_tolerance = 0.1)
+        : SparseLU(A, sparse_lu_analyze(A, ordering), pivot_tolerance) {}
+
+    size_t size() const { return sym_.n; }
+    bool singular() const { return !regular_; }
+    const SparseSymbolic& symbolic() const { return sym_; }
+    size_t nonzeros_L() const { return Li_.size() + sym_.n; }
+    size_t nonzeros_U() const { return Ui_.size(); }
+    size_t off_diagonal_pivots() const { return off_diagonal_pivots_; }
+
+    // Rozkład nowej macierzy o tym samym wzorcu, bez przeszukiwania grafu
+    // i bez wyboru elementu głównego: wzorce L, U i permutacja P zostają.
+    // Gdy któryś element główny nie spełnia progu (albo poprzedni rozkład
+    // był osobliwy), wykonuje pełny rozkład i zwraca false.
+    bool refactor(const CsrMatrix& A) {
+        if (!sym_.matches(A)) throw std::invalid_argument("SparseLU::refactor: wzorzec macierzy niezgodny z analizą");
+        if (regular_ && refactor_numeric(A)) return true;
+        factor(A);
+        return false;
+    }
+
+    void solve_in_place(std::vector<double>& b) const {
+        check(b.size());
+        const size_t n = sym_.n;
+        std::vector<double> y(n);
+        for (size_t i = 0; i < n; ++i) y[pinv_[i]] = b[i];
+        for (size_t k = 0; k < n; ++k) {
+            const double yk = y[k];
+            for (size_t p = Lp_[k]; p < Lp_[k + 1]; ++p) y[Li_[p]] -= Lx_[p] * yk;
+        }
+        for (size_t k = n; k-- > 0;) {
+            const size_t diag = Up_[k + 1] - 1;
+            const double yk = y[k] /= Ux_[diag];
+            for (size_t p = Up_[k]; p < diag; ++p) y[Ui_[p]] -= Ux_[p] * yk;
+        }
+        for (size_t k = 0; k < n; ++k) b[sym_.q[k]] = y[k];
+    }
+
+    std::vector<double> solve(std::vector<double> b) const {
+        solve_in_place(b);
+        return b;
+    }
+
+private:
+    // Algorytm Gilberta-Peierlsa: dla kolumny k rozwiązujemy L x = A(:, q[k])
+    // z rzadką prawą stroną. Wzorzec x to zbiór wierzchołków osiągalnych
+    // w grafie L z niezerowych A(:, q[k]); DFS daje je w porządku
+    // topologicznym, więc koszt jest proporcjonalny do liczby operacji.
+    // W trakcie rozkładu Li_ trzyma oryginalne numery wierszy.
+    void factor(const CsrMatrix& A) {
+        const size_t n = sym_.n;
+        regular_ = true;
+        off_diagonal_pivots_ = 0;
+        Lp_.assign(n + 1, 0);
+        Up_.assign(n + 1, 0);
+        Li_.clear();
+        Lx_.clear();
+        Ui_.clear();
+        Ux_.clear();
+        Li_.reserve(sym_.fill_estimate);
+        Lx_.reserve(sym_.fill_estimate);
+        Ui_.reserve(sym_.fill_estimate);
+        Ux_.reserve(sym_.fill_estimate);
+        pinv_.assign(n, SPARSE_NONE);
+
+        std::vector<double> x(n, 0.0);
+        std::vector<size_t> xi(n), stack(n), pstack(n);
+        std::vector<char> visited(n, 0);
+
+        for (size_t k = 0; k < n; ++k) {
+            const size_t col = sym_.q[k];
+
+            // osiągalność: xi[top..n) w porządku topologicznym
+            size_t top = n;
+            for (size_t p = sym_.col_ptr[col]; p < sym_.col_ptr[col + 1]; ++p) {
+                const size_t start = sym_.row_idx[p];
+                if (visited[start]) continue;
+                size_t depth = 0;
+                stack[0] = start;
+                for (;;) {
+                    const size_t j = stack[depth];
+                    const size_t J = pinv_[j];
+                    if (!visited[j]) {
+                        visited[j] = 1;
+                        pstack[depth] = J == SPARSE_NONE ? 0 : Lp_[J];
+                    }
+                    const size_t end = J == SPARSE_NONE ? 0 : Lp_[J + 1];
+                    bool done = true;
+                    for (size_t q = pstack[depth]; q < end; ++q) {
+                        if (!visited[Li_[q]]) {
+                            pstack[depth] = q + 1;
+                            stack[++depth] = Li_[q];
+                            done = false;
+                            break;
+                        }
+                    }
+                    if (done) {
+                        xi[--top] = j;
+                        if (depth == 0) break;
+                        --depth;
+                    }
+                }
+            }
+
+            // rzadkie podstawianie w przód
+            for (size_t p = sym_.col_ptr[col]; p < sym_.col_ptr[col + 1]; ++p) {
+                x[sym_.row_idx[p]] = A.values[sym_.csr_pos[p]];
+            }
+            for (size_t t = top; t < n; ++t) {
+                const size_t J = pinv_[xi[t]];
+                if (J == SPARSE_NONE) continue;
+                const double xj = x[xi[t]];
+                for (size_t p = Lp_[J]; p < Lp_[J + 1]; ++p) x[Li_[p]] -= Lx_[p] * xj;
+            }
+
+            // U(:, k) i wybór elementu głównego spośród wierszy jeszcze nie użytych
+            size_t ipiv = SPARSE_NONE;
+            double amax = 0.0;
+            for (size_t t = top; t < n; ++t) {
+                const size_t i = xi[t];
+                if (pinv_[i] == SPARSE_NONE) {
+                    if (std::abs(x[i]) > amax) {
+                        amax = std::abs(x[i]);
+                        ipiv = i;
+                    }
+                } else {
+                    Ui_.push_back(pinv_[i]);
+                    Ux_.push_back(x[i]);
+                }
+            }
+            if (ipiv == SPARSE_NONE || !std::isfinite(amax)) {
+                regular_ = false;
+                for (size_t t = top; t < n; ++t) {
+                    x[xi[t]] = 0.0;
+                    visited[xi[t]] = 0;
+                }
+                return;
+            }
+            if (pinv_[col] == SPARSE_NONE && std::abs(x[col]) >= tol_ * amax && x[col] != 0.0) {
+                ipiv = col;
+            } else {
+                off_diagonal_pivots_++;
+            }
+            const double pivot = x[ipiv];
+            Ui_.push_back(k);
+            Ux_.push_back(pivot);
+            pinv_[ipiv] = k;
+
+            for (size_t t = top; t < n; ++t) {
+                const size_t i = xi[t];
+                if (pinv_[i] == SPARSE_NONE) {
+                    Li_.push_back(i);
+                    Lx_.push_back(x[i] / pivot);
+                }
+                x[i] = 0.0;
+                visited[i] = 0;
+            }
+            Lp_[k + 1] = Li_.size();
+            Up_[k + 1] = Ui_.size();
+        }
+        for (size_t& i : Li_) i = pinv_[i];
+    }
+
+    // Ten sam przebieg na gotowych wzorcach; kolumny U są zapisane
+    // w porządku topologicznym, więc wystarczy je przejść po kolei
+    bool refactor_numeric(const CsrMatrix& A) {
+        const size_t n = sym_.n;
+        std::vector<double> x(n, 0.0);
+        for (size_t k = 0; k < n; ++k) {
+            const size_t col = sym_.q[k];
+            for (size_t p = sym_.col_ptr[col]; p < sym_.col_ptr[col + 1]; ++p) {
+                x[pinv_[sym_.row_idx[p]]] = A.values[sym_.csr_pos[p]];
+            }
+            const size_t diag = Up_[k + 1] - 1;
+            for (size_t p = Up_[k]; p < diag; ++p) {
+                const size_t j = Ui_[p];
+                const double xj = Ux_[p] = x[j];
+                x[j] = 0.0;
+                for (size_t q = Lp_[j]; q < Lp_[j + 1]; ++q) x[Li_[q]] -= Lx_[q] * xj;
+            }
+            const double pivot = x[k];
+            x[k] = 0.0;
+            double amax = std::abs(pivot);
+            for (size_t p = Lp_[k]; p < Lp_[k + 1]; ++p) amax = std::max(amax, std::abs(x[Li_[p]]));
+            if (pivot == 0.0 || !std::isfinite(amax) || std::abs(pivot) < tol_ * amax) return false;
+            Ux_[diag] = pivot;
+            for (size_t p = Lp_[k]; p < Lp_[k + 1]; ++p) {
+                Lx_[p] = x[Li_[p]] / pivot;
+                x[Li_[p]] = 0.0;
+            }
+        }
+        return true;
+    }
+
+    void check(size_t rows) const {
+        if (rows != size()) throw std::invalid_argument("SparseLU::solve: zły rozmiar prawej strony");
+        if (!regular_) throw std::runtime_error("SparseLU::solve: macierz osobliwa");
+    }
+
+    SparseSymbolic sym_;
+    double tol_;
+    bool regular_ = true;
+    size_t off_diagonal_pivots_ = 0;
+    std::vector<size_t> pinv_;     // pinv_[i] = krok, w którym wiersz i był wierszem głównym
+    std::vector<size_t> Lp_, Li_;
+    std::vector<double> Lx_;
+    std::vector<size_t> Up_, Ui_;
+    std::vector<double> Ux_;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pula wątków z podkradaniem zadań (work stealing). Każdy wątek ma własną
+// kolejkę: zadania zlecone z wnętrza zadania trafiają na jej koniec i są
+// brane stamtąd w pierwszej kolejności (LIFO, ciepły cache), a bezczynne
+// wątki kradną z początku cudzych kolejek. Wątek wołający wait() też
+// wykonuje zadania, więc pula o rozmiarze 1 nie tworzy żadnych wątków.
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(unsigned threads = std::thread::hardware_concurrency()) {
+        if (threads == 0) threads = 1;
+        for (unsigned i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+        for (unsigned i = 1; i < threads; ++i) workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lk(sleep_mutex_);
+            stop_ = true;
+        }
+        sleep_cv_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(queues_.size()); }
+
+    void submit(Task task) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        unsigned q = current_pool_ == this ? current_index_
+                                           : next_queue_.fetch_add(1, std::memory_order_relaxed) % size();
+        {
+            std::lock_guard<std::mutex> lk(queues_[q]->mutex);
+            queued_.fetch_add(1, std::memory_order_release);
+            queues_[q]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lk(sleep_mutex_);
+        }
+        sleep_cv_.notify_one();
+    }
+
+    // Czeka na zakończenie wszystkich zleconych zadań (także tych zleconych
+    // w trakcie), wykonując je razem z pulą jako wątek o indeksie 0
+    void wait() {
+        WorkStealingPool* saved_pool = current_pool_;
+        unsigned saved_index = current_index_;
+        current_pool_ = this;
+        current_index_ = 0;
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            Task task;
+            if (take(0, task)) {
+                run(task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        current_pool_ = saved_pool;
+        current_index_ = saved_index;
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool take(unsigned self, Task& task) {
+        {
+            Queue& own = *queues_[self];
+            std::lock_guard<std::mutex> lk(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        for (unsigned k = 1; k < size(); ++k) {
+            Queue& other = *queues_[(self + k) % size()];
+            std::lock_guard<std::mutex> lk(other.mutex);
+            if (!other.tasks.empty()) {
+                task = std::move(other.tasks.front());
+                other.tasks.pop_front();
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(Task& task) {
+        task();
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void worker_loop(unsigned index) {
+        current_pool_ = this;
+        current_index_ = index;
+        for (;;) {
+            Task task;
+            if (take(index, task)) {
+                run(task);
+                continue;
+            }
+            std::unique_lock<std::mutex> lk(sleep_mutex_);
+            sleep_cv_.wait(lk, [this] { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+            if (stop_) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> queued_{0};
+    std::atomic<unsigned> next_queue_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stop_ = false;
+
+    static inline thread_local WorkStealingPool* current_pool_ = nullptr;
+    static inline thread_local unsigned current_index_ = 0;
+};
+
+#endif
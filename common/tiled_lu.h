@@ -0,0 +1,87 @@
+#ifndef TILED_LU_H
+#define TILED_LU_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "lu.h"
+#include "thread_pool.h"
+
+// Wielowątkowy rozkład PA = LU na blokach kolumn. Graf zadań:
+//   panel(k)     - rozkład kolumn bloku k z wyborem elementu głównego,
+//   update(k, j) - zamiany wierszy z panelu k, U_kj = L_kk^{-1} A_kj
+//                  i A_ij -= L_ik U_kj dla bloku kolumn j > k.
+// update(k, j) czeka na panel(k) i update(k-1, j); panel(k) czeka na
+// update(k-1, k). Po panelu k zadanie update(k, k+1) trafia na wierzch
+// kolejki, więc panel(k+1) rusza, zanim skończą się pozostałe aktualizacje
+// kroku k (lookahead) i nie blokuje całej puli.
+// Wynik i zawartość piv są takie same jak w lu_factor_inplace.
+inline bool lu_factor_tiled(MatrixView A, std::vector<size_t>& piv, WorkStealingPool& pool,
+                            size_t block = 0) {
+    const size_t n = A.rows;
+    if (A.cols != n) throw std::invalid_argument("lu_factor_tiled: macierz musi być kwadratowa");
+    piv.resize(n);
+    if (n == 0) return true;
+    if (block == 0) block = n <= 2000 ? 64 : 128;
+    const size_t nt = (n + block - 1) / block;
+
+    // liczniki brakujących zależności: update(k, j) pod k * nt + j, panel(k) pod k * nt + k
+    std::unique_ptr<std::atomic<int>[]> deps(new std::atomic<int>[nt * nt]);
+    for (size_t k = 0; k < nt; ++k) {
+        for (size_t j = k; j < nt; ++j) {
+            deps[k * nt + j].store(k == 0 ? (j == k ? 0 : 1) : (j == k ? 1 : 2), std::memory_order_relaxed);
+        }
+    }
+    std::atomic<bool> regular{true};
+
+    auto col0 = [&](size_t k) { return k * block; };
+    auto col1 = [&](size_t k) { return std::min(n, (k + 1) * block); };
+
+    std::function<void(size_t, size_t)> update;
+    std::function<void(size_t)> panel;
+    auto release = [&](size_t k, size_t j) {
+        if (deps[k * nt + j].fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        if (k == j) {
+            pool.submit([&panel, k] { panel(k); });
+        } else {
+            pool.submit([&update, k, j] { update(k, j); });
+        }
+    };
+
+    panel = [&](size_t k) {
+        const size_t k0 = col0(k), k1 = col1(k);
+        if (!lu_factor_panel(A, k0, k1 - k0, piv, false)) regular = false;
+        // od najdalszej kolumny, żeby update(k, k+1) był zdjęty jako pierwszy
+        for (size_t j = nt; j-- > k + 1;) release(k, j);
+    };
+
+    update = [&](size_t k, size_t j) {
+        const size_t k0 = col0(k), k1 = col1(k), j0 = col0(j), j1 = col1(j);
+        for (size_t i = k0; i < k1; ++i) {
+            if (piv[i] != i) std::swap_ranges(A.row(i) + j0, A.row(i) + j1, A.row(piv[i]) + j0);
+        }
+        lu_update_block(A, k0, k1, j0, j1);
+        if (k + 1 < nt) release(k + 1, j);
+    };
+
+    pool.submit([&panel] { panel(0); });
+    pool.wait();
+
+    // zamiany z późniejszych paneli w kolumnach na lewo od nich (L)
+    for (size_t k = 1; k < nt; ++k) {
+        const size_t k0 = col0(k);
+        for (size_t i = k0; i < col1(k); ++i) {
+            if (piv[i] != i) std::swap_ranges(A.row(i), A.row(i) + k0, A.row(piv[i]));
+        }
+    }
+    return regular;
+}
+
+inline LUFactorization lu_factorize_parallel(Matrix A, WorkStealingPool& pool, size_t block = 0) {
+    A.apply_permutation();
+    std::vector<size_t> piv;
+    bool regular = lu_factor_tiled(A.view(), piv, pool, block);
+    return LUFactorization::from_factors(std::move(A), std::move(piv), regular);
+}
+
+#endif
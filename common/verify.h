@@ -0,0 +1,156 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include "matrix.h"
+#include "lu.h"
+
+// Tania weryfikacja wyników, O(N^2) zamiast O(N^3):
+//   verify_lu      - probabilistyczny test Freivaldsa, czy L U = P A,
+//   backward_error - błąd wsteczny rozwiązania Ax = b z residuum.
+//
+// Test Freivaldsa: zamiast mnożyć L U porównujemy L (U r) z P A r dla
+// losowego wektora r o elementach +-1. Porównanie jest po składowych
+// z tolerancją z oszacowania błędu zaokrągleń rozkładu LU,
+// |P A - L U| <= gamma_N |L| |U|, gamma_N = N eps / (1 - N eps), więc
+// tolerancja to safety * gamma_N (|L| (|U| |r|) + |P A| |r|) (drugi
+// składnik pokrywa zaokrąglenia samego mnożenia A r). Jeśli któryś element
+// E = P A - L U przekracza swoją tolerancję, pojedyncza próba go przeoczy
+// z prawdopodobieństwem co najwyżej 1/2 (zmiana znaku r_j przesuwa
+// (E r)_i o 2|E_ij|, więc oba warianty nie zmieszczą się w tolerancji).
+// k prób daje pewność 1 - 2^-k; liczba prób wynika z żądanej pewności.
+
+struct VerificationOptions {
+    double confidence = 1.0 - 1e-6;  // prawdopodobieństwo wykrycia błędnego rozkładu
+    double safety = 10.0;            // mnożnik tolerancji z oszacowania gamma_N
+    unsigned seed = 12345;
+};
+
+struct VerificationResult {
+    bool passed = true;
+    int trials = 0;
+    double confidence = 0.0;  // osiągnięte 1 - 2^-trials
+    double max_ratio = 0.0;   // max_i |(L U r - P A r)_i| / tolerancja_i; > 1 to błąd
+};
+
+inline int freivalds_trials(double confidence) {
+    if (!(confidence > 0.0) || !(confidence < 1.0)) {
+        throw std::invalid_argument("freivalds_trials: pewność musi być w przedziale (0, 1)");
+    }
+    return std::max(1, static_cast<int>(std::ceil(-std::log2(1.0 - confidence))));
+}
+
+// Czynniki podane wprost: L dolnotrójkątna z jedynkami na przekątnej (jak
+// w LUFactorization zapisana razem z U w jednej macierzy), perm[i] to wiersz
+// A na pozycji i w P A
+inline VerificationResult verify_lu(const Matrix& A, const Matrix& factors, const std::vector<size_t>& perm,
+                                    const VerificationOptions& opt = {}) {
+    const size_t n = A.rows();
+    if (A.cols() != n || factors.rows() != n || factors.cols() != n || perm.size() != n) {
+        throw std::invalid_argument("verify_lu: niezgodne wymiary");
+    }
+    const double eps = std::numeric_limits<double>::epsilon();
+    const double gamma = n * eps < 1.0 ? n * eps / (1.0 - n * eps) : std::numeric_limits<double>::infinity();
+
+    VerificationResult res;
+    res.trials = freivalds_trials(opt.confidence);
+    res.confidence = 1.0 - std::ldexp(1.0, -res.trials);
+
+    std::mt19937 gen(opt.seed);
+    std::vector<double> r(n), u(n), ua(n), Ar(n), Aa(n);
+    for (size_t i = 0; i < n; ++i) {
+        const double* Ai = A.row(i);
+        double s = 0.0;
+        for (size_t j = 0; j < n; ++j) s += std::abs(Ai[j]);
+        Aa[i] = s;
+    }
+    for (int t = 0; t < res.trials; ++t) {
+        for (double& e : r) e = gen() & 1 ? 1.0 : -1.0;
+
+        // u = U r, ua = |U| |r| (|r| = 1)
+        for (size_t i = 0; i < n; ++i) {
+            const double* Fi = factors.row(i);
+            double s = 0.0, sa = 0.0;
+            for (size_t j = i; j < n; ++j) {
+                s += Fi[j] * r[j];
+                sa += std::abs(Fi[j]);
+            }
+            u[i] = s;
+            ua[i] = sa;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            const double* Ai = A.row(i);
+            double s = 0.0;
+            for (size_t j = 0; j < n; ++j) s += Ai[j] * r[j];
+            Ar[i] = s;
+        }
+        // (L u)_i i (|L| ua)_i porównywane z (P A r)_i
+        for (size_t i = 0; i < n; ++i) {
+            const double* Fi = factors.row(i);
+            double s = u[i], sa = ua[i];
+            for (size_t j = 0; j < i; ++j) {
+                s += Fi[j] * u[j];
+                sa += std::abs(Fi[j]) * ua[j];
+            }
+            const double diff = std::abs(s - Ar[perm[i]]);
+            const double tol = opt.safety * gamma * (sa + Aa[perm[i]]);
+            const double ratio = tol > 0.0 ? diff / tol : (diff > 0.0 ? std::numeric_limits<double>::infinity() : 0.0);
+            if (!(ratio <= res.max_ratio)) res.max_ratio = ratio;  // przepuszcza NaN
+        }
+    }
+    res.passed = res.max_ratio <= 1.0;
+    return res;
+}
+
+inline VerificationResult verify_lu(const Matrix& A, const LUFactorization& lu, const VerificationOptions& opt = {}) {
+    return verify_lu(A, lu.factors(), lu.permutation(), opt);
+}
+
+// Błąd wsteczny przybliżonego rozwiązania x:
+//   normwise      - ||b - Ax|| / (||A|| ||x|| + ||b||) (Rigal, Gaches),
+//                   najmniejsze względne zaburzenie A i b, dla którego x
+//                   jest dokładnym rozwiązaniem,
+//   componentwise - max_i |b - Ax|_i / (|A||x| + |b|)_i (Oettli, Prager).
+// Stabilny algorytm daje wartości rzędu N eps; acceptable() sprawdza to
+// z tym samym zapasem co verify_lu.
+struct BackwardError {
+    double normwise = 0.0;
+    double componentwise = 0.0;
+    double residual = 0.0;  // ||b - Ax|| w normie maksimum
+
+    bool acceptable(size_t n, double safety = 10.0) const {
+        return normwise <= safety * n * std::numeric_limits<double>::epsilon();
+    }
+};
+
+inline BackwardError backward_error(const Matrix& A, const std::vector<double>& x, const std::vector<double>& b) {
+    const size_t n = A.rows();
+    if (A.cols() != x.size() || b.size() != n) throw std::invalid_argument("backward_error: niezgodne wymiary");
+    BackwardError e;
+    double normA = 0.0, normx = 0.0, normb = 0.0;
+    for (size_t j = 0; j < x.size(); ++j) normx = std::max(normx, std::abs(x[j]));
+    for (size_t i = 0; i < n; ++i) {
+        const double* Ai = A.row(i);
+        double s = b[i], row = 0.0, bound = std::abs(b[i]);
+        for (size_t j = 0; j < x.size(); ++j) {
+            s -= Ai[j] * x[j];
+            row += std::abs(Ai[j]);
+            bound += std::abs(Ai[j]) * std::abs(x[j]);
+        }
+        normA = std::max(normA, row);
+        normb = std::max(normb, std::abs(b[i]));
+        if (!(std::abs(s) <= e.residual)) e.residual = std::abs(s);
+        const double c = bound > 0.0 ? std::abs(s) / bound : (s != 0.0 ? std::numeric_limits<double>::infinity() : 0.0);
+        if (!(c <= e.componentwise)) e.componentwise = c;
+    }
+    const double denom = normA * normx + normb;
+    e.normwise = denom > 0.0 ? e.residual / denom : 0.0;
+    return e;
+}
+
+#endif
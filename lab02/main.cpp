@@ -4,23 +4,209 @@
 #include <vector>
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#include <immintrin.h>
+#include <thread>
+#include <stdexcept>
 
 using namespace std;
 
-// Funkcja interpolacji Lagrange’a
-double lagrangeInterpolation(const vector<double>& nodes, const vector<double>& values, double x) {
-    double result = 0.0;
-    int n = nodes.size();
-    for (int i = 0; i < n; i++) {
-        double term = values[i];
-        for (int j = 0; j < n; j++) {
-            if (j != i)
-                term *= (x - nodes[j]) / (nodes[i] - nodes[j]);
+// Jądra wsadowe dla wzoru barycentrycznego: kilka wartości x naraz w rejestrach
+// wektorowych. Indeksy punktów trafiających dokładnie w węzeł trafiają do hits
+// i są potem liczone skalarnie.
+__attribute__((target("avx2,fma")))
+static void barycentricBatchAVX2(const double* nodes, const double* w, const double* wy, size_t n,
+                                 const double* x, double* out, size_t count, vector<size_t>& hits) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    for (size_t k = 0; k + 4 <= count; k += 4) {
+        __m256d xv = _mm256_loadu_pd(x + k);
+        __m256d num = zero, den = zero, hit = zero;
+        for (size_t i = 0; i < n; i++) {
+            __m256d diff = _mm256_sub_pd(xv, _mm256_set1_pd(nodes[i]));
+            hit = _mm256_or_pd(hit, _mm256_cmp_pd(diff, zero, _CMP_EQ_OQ));
+            __m256d t = _mm256_div_pd(one, diff);
+            num = _mm256_fmadd_pd(_mm256_set1_pd(wy[i]), t, num);
+            den = _mm256_fmadd_pd(_mm256_set1_pd(w[i]), t, den);
         }
-        result += term;
+        _mm256_storeu_pd(out + k, _mm256_div_pd(num, den));
+        int mask = _mm256_movemask_pd(hit);
+        for (int l = 0; l < 4; l++)
+            if (mask & (1 << l)) hits.push_back(k + l);
     }
-    return result;
 }
+
+__attribute__((target("avx512f")))
+static void barycentricBatchAVX512(const double* nodes, const double* w, const double* wy, size_t n,
+                                   const double* x, double* out, size_t count, vector<size_t>& hits) {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1.0);
+    for (size_t k = 0; k + 8 <= count; k += 8) {
+        __m512d xv = _mm512_loadu_pd(x + k);
+        __m512d num = zero, den = zero;
+        __mmask8 hit = 0;
+        for (size_t i = 0; i < n; i++) {
+            __m512d diff = _mm512_sub_pd(xv, _mm512_set1_pd(nodes[i]));
+            hit |= _mm512_cmp_pd_mask(diff, zero, _CMP_EQ_OQ);
+            __m512d t = _mm512_div_pd(one, diff);
+            num = _mm512_fmadd_pd(_mm512_set1_pd(wy[i]), t, num);
+            den = _mm512_fmadd_pd(_mm512_set1_pd(w[i]), t, den);
+        }
+        _mm512_storeu_pd(out + k, _mm512_div_pd(num, den));
+        for (int l = 0; l < 8; l++)
+            if (hit & (1 << l)) hits.push_back(k + l);
+    }
+}
+
+// Interpolator Lagrange'a w postaci barycentrycznej (druga postać wzoru).
+// Wagi w_i = 1 / prod_{j != i} (x_i - x_j) liczone są raz w O(n^2),
+// każde obliczenie wartości kosztuje O(n), a zmiana samych wartości
+// w węzłach (przy tych samych x) to O(n).
+class BarycentricInterpolator {
+public:
+    BarycentricInterpolator(const vector<double>& nodes, const vector<double>& values)
+        : nodes_(nodes), weights_(nodes.size()), weightedValues_(nodes.size()) {
+        checkSize(values);
+        computeWeights();
+        setValues(values);
+    }
+
+    // Podmiana wartości w węzłach bez przeliczania wag.
+    void setValues(const vector<double>& values) {
+        checkSize(values);
+        values_ = values;
+        for (size_t i = 0; i < nodes_.size(); i++) {
+            weightedValues_[i] = weights_[i] * values_[i];
+        }
+    }
+
+    double operator()(double x) const {
+        if (nodes_.empty()) return 0.0;
+        double numerator = 0.0;
+        double denominator = 0.0;
+        for (size_t i = 0; i < nodes_.size(); i++) {
+            double diff = x - nodes_[i];
+            if (diff == 0.0) {
+                return values_[i]; // x trafia dokładnie w węzeł
+            }
+            double t = 1.0 / diff;
+            numerator += weightedValues_[i] * t;
+            denominator += weights_[i] * t;
+        }
+        return numerator / denominator;
+    }
+
+    // Obliczanie wartości dla całej tablicy x (out[k] = p(x[k])).
+    void evaluate(const double* x, double* out, size_t count) const {
+        if (nodes_.empty()) {
+            fill(out, out + count, 0.0);
+            return;
+        }
+        size_t done = 0;
+        vector<size_t> hits;
+        if (__builtin_cpu_supports("avx512f")) {
+            done = count - count % 8;
+            barycentricBatchAVX512(nodes_.data(), weights_.data(), weightedValues_.data(), nodes_.size(),
+                                   x, out, done, hits);
+        } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            done = count - count % 4;
+            barycentricBatchAVX2(nodes_.data(), weights_.data(), weightedValues_.data(), nodes_.size(),
+                                 x, out, done, hits);
+        }
+        for (size_t k : hits) out[k] = (*this)(x[k]);
+        for (size_t k = done; k < count; k++) out[k] = (*this)(x[k]);
+    }
+
+    const vector<double>& nodes() const { return nodes_; }
+    const vector<double>& weights() const { return weights_; }
+
+private:
+    void checkSize(const vector<double>& values) const {
+        if (values.size() != nodes_.size())
+            throw invalid_argument("BarycentricInterpolator: liczba wartości różna od liczby węzłów");
+    }
+
+    void computeWeights() {
+        int n = nodes_.size();
+        if (n == 0) return;
+        // Różnice mnożymy przez 4/(b-a), żeby iloczyny nie wychodziły poza
+        // zakres double dla setek węzłów; wspólny czynnik skraca się we wzorze.
+        double lo = nodes_[0], hi = nodes_[0];
+        for (double x : nodes_) {
+            lo = min(lo, x);
+            hi = max(hi, x);
+        }
+        double scale = (hi > lo) ? 4.0 / (hi - lo) : 1.0;
+        for (int i = 0; i < n; i++) {
+            double w = 1.0;
+            for (int j = 0; j < n; j++) {
+                if (j != i)
+                    w *= (nodes_[i] - nodes_[j]) * scale;
+            }
+            weights_[i] = 1.0 / w;
+        }
+    }
+
+    vector<double> nodes_;
+    vector<double> values_;
+    vector<double> weights_;
+    vector<double> weightedValues_;
+};
+
+// Funkcja interpolacji Lagrange’a (pojedynczy punkt, bez ponownego użycia wag)
+double lagrangeInterpolation(const vector<double>& nodes, const vector<double>& values, double x) {
+    return BarycentricInterpolator(nodes, values)(x);
+}
+// Wielomian interpolacyjny w postaci Newtona budowany przyrostowo: dodanie
+// k-tego węzła kosztuje O(k) (przechowujemy ostatnią przekątną tablicy ilorazów
+// różnicowych), a współczynniki wcześniejszych węzłów się nie zmieniają.
+// Zmienna jest przeskalowana na przedział długości ~4, żeby iloczyny
+// (x - x_0)...(x - x_k) nie uciekały poza zakres double dla setek węzłów.
+class IncrementalNewton {
+public:
+    IncrementalNewton(double x_min, double x_max)
+        : center_(0.5 * (x_min + x_max)), scale_(x_max > x_min ? 4.0 / (x_max - x_min) : 1.0) {}
+
+    // Dodaje węzeł i zwraca nowy współczynnik f[x_0, ..., x_k].
+    double addNode(double x, double y) {
+        double t = toLocal(x);
+        size_t k = nodes_.size();
+        // diagonal_[j] = f[x_{k-j}, ..., x_k]; nadpisujemy ją w miejscu
+        double carry = y;
+        for (size_t j = 0; j < k; j++) {
+            double old = diagonal_[j];
+            diagonal_[j] = carry;
+            carry = (carry - old) / (t - nodes_[k - 1 - j]);
+        }
+        diagonal_.push_back(carry);
+        nodes_.push_back(t);
+        coefficients_.push_back(carry);
+        return carry;
+    }
+
+    double operator()(double x) const {
+        double t = toLocal(x);
+        size_t n = coefficients_.size();
+        if (n == 0) return 0.0;
+        double result = coefficients_[n - 1];
+        for (size_t i = n - 1; i-- > 0;) {
+            result = result * (t - nodes_[i]) + coefficients_[i];
+        }
+        return result;
+    }
+
+    double toLocal(double x) const { return (x - center_) * scale_; }
+    size_t size() const { return nodes_.size(); }
+    const vector<double>& localNodes() const { return nodes_; }
+    const vector<double>& coefficients() const { return coefficients_; }
+
+private:
+    double center_, scale_;
+    vector<double> nodes_;
+    vector<double> coefficients_;
+    vector<double> diagonal_;
+};
+
 //wczytanie danych z pliku
 bool readData(const string& filename, vector<double>& xs, vector<double>& ys) {
     ifstream infile(filename);
@@ -72,24 +258,197 @@ void selectNodes(const vector<double>& xs, const vector<double>& ys, int step,
 // Funkcja obliczająca średni błąd kwadratowy dla punktów, które nie są węzłami.
 double computeMSE(const vector<double>& xs, const vector<double>& ys, 
                     const vector<double>& nodes, const vector<double>& nodeValues) {
-    double errorSum = 0.0;
-    int count = 0;
+    // Węzły sortujemy raz i sprawdzamy przynależność wyszukiwaniem binarnym.
+    vector<double> sortedNodes(nodes);
+    sort(sortedNodes.begin(), sortedNodes.end());
+    vector<double> queryX, queryY;
     for (size_t i = 0; i < xs.size(); i++) {
-        bool isNode = false;
-        for (double xnode : nodes) {
-            if (fabs(xs[i] - xnode) < 1e-6) {
-                isNode = true;
-                break;
+        auto it = lower_bound(sortedNodes.begin(), sortedNodes.end(), xs[i] - 1e-6);
+        bool isNode = it != sortedNodes.end() && fabs(xs[i] - *it) < 1e-6;
+        if (!isNode) {
+            queryX.push_back(xs[i]);
+            queryY.push_back(ys[i]);
+        }
+    }
+    BarycentricInterpolator interpolator(nodes, nodeValues);
+    vector<double> interpVals(queryX.size());
+    interpolator.evaluate(queryX.data(), interpVals.data(), queryX.size());
+    double errorSum = 0.0;
+    int count = queryX.size();
+    for (int i = 0; i < count; i++) {
+        double diff = interpVals[i] - queryY[i];
+        errorSum += diff * diff;
+    }
+    return (count > 0) ? errorSum / count : 0.0;
+}
+
+// Kolejność dodawania węzłów (indeksy danych) od zgrubnej do drobnej: najpierw
+// końce, potem kolejne środki przedziałów poziom po poziomie. Równomiernie
+// (z dokładnością do zaokrąglenia indeksu) rozłożone są tylko prefiksy
+// kończące pełny poziom: 2, 3, 5, 9, ... węzłów; ich długości trafiają do
+// levelEnds. Prefiksy pośrednie zagęszczają tylko część przedziału.
+vector<int> nestedNodeOrder(int total, vector<int>* levelEnds = nullptr) {
+    vector<int> order;
+    if (levelEnds) levelEnds->clear();
+    if (total <= 0) return order;
+    order.push_back(0);
+    if (total == 1) return order;
+    order.push_back(total - 1);
+    if (levelEnds) levelEnds->push_back(order.size());
+    vector<pair<int, int>> level = {{0, total - 1}};
+    while (!level.empty()) {
+        vector<pair<int, int>> next;
+        for (const auto& interval : level) {
+            int lo = interval.first, hi = interval.second;
+            if (hi - lo < 2) continue;
+            int mid = (lo + hi) / 2;
+            order.push_back(mid);
+            next.push_back({lo, mid});
+            next.push_back({mid, hi});
+        }
+        if (levelEnds && !next.empty()) levelEnds->push_back(order.size());
+        level.swap(next);
+    }
+    return order;
+}
+
+// MSE (dla punktów spoza węzłów) dla każdej liczby węzłów k = 1..order.size(),
+// gdzie dla k węzłów bierzemy pierwsze k indeksów z 'order'. Współczynniki
+// Newtona liczone są raz, a każdy punkt danych przechodzi przez wszystkie k
+// jednym przebiegiem (p_{k+1}(x) = p_k(x) + c_k * prod_{j<k} (x - x_j)),
+// więc cały przegląd kosztuje O(m * n_max). Punkty dzielone są między wątki.
+// Wynik: mse[k] dla k węzłów (mse[0] nieużywane).
+vector<double> sweepNodeCounts(const vector<double>& xs, const vector<double>& ys,
+                               const vector<int>& order, unsigned numThreads = 0) {
+    int m = xs.size();
+    int n = order.size();
+    vector<double> mse(n + 1, 0.0);
+    if (m == 0 || n == 0) return mse;
+
+    double x_min = *min_element(xs.begin(), xs.end());
+    double x_max = *max_element(xs.begin(), xs.end());
+    IncrementalNewton newton(x_min, x_max);
+    for (int idx : order) newton.addNode(xs[idx], ys[idx]);
+    const vector<double>& t = newton.localNodes();
+    const vector<double>& c = newton.coefficients();
+
+    // nodeStep[i] = pozycja punktu i w kolejności węzłów (n, jeśli nie jest węzłem);
+    // punkt jest węzłem dla wszystkich k > nodeStep[i].
+    vector<int> nodeStep(m, n);
+    for (int k = 0; k < n; k++) nodeStep[order[k]] = k;
+
+    if (numThreads == 0) numThreads = max(1u, thread::hardware_concurrency());
+    numThreads = min<unsigned>(numThreads, m);
+    vector<vector<double>> partialSums(numThreads, vector<double>(n + 1, 0.0));
+    vector<vector<int>> partialCounts(numThreads, vector<int>(n + 1, 0));
+
+    auto worker = [&](unsigned id) {
+        int begin = static_cast<long long>(m) * id / numThreads;
+        int end = static_cast<long long>(m) * (id + 1) / numThreads;
+        vector<double>& sums = partialSums[id];
+        vector<int>& counts = partialCounts[id];
+        for (int i = begin; i < end; i++) {
+            double x = newton.toLocal(xs[i]);
+            double value = c[0];
+            double product = 1.0;
+            int last = min(nodeStep[i], n); // dla k > nodeStep[i] punkt jest węzłem
+            for (int k = 1; k <= last; k++) {
+                if (k > 1) {
+                    product *= (x - t[k - 2]);
+                    value += c[k - 1] * product;
+                }
+                double diff = value - ys[i];
+                sums[k] += diff * diff;
+                counts[k]++;
             }
         }
-        if (!isNode) {
-            double interpVal = lagrangeInterpolation(nodes, nodeValues, xs[i]);
-            double diff = interpVal - ys[i];
+    };
+
+    vector<thread> threads;
+    for (unsigned id = 1; id < numThreads; id++) threads.emplace_back(worker, id);
+    worker(0);
+    for (auto& th : threads) th.join();
+
+    for (int k = 1; k <= n; k++) {
+        double sum = 0.0;
+        int count = 0;
+        for (unsigned id = 0; id < numThreads; id++) {
+            sum += partialSums[id][k];
+            count += partialCounts[id][k];
+        }
+        mse[k] = (count > 0) ? sum / count : 0.0;
+    }
+    return mse;
+}
+
+// Wynik adaptacyjnego doboru węzłów.
+struct AdaptiveNodes {
+    vector<int> indices; // indeksy węzłów w kolejności dodawania
+    double mse;          // MSE dla punktów spoza węzłów
+};
+
+// Zachłanny dobór węzłów: startujemy od kilku węzłów (z nestedNodeOrder)
+// i dokładamy punkt danych o największym residuum, aż MSE spadnie do
+// targetMSE albo skończy się budżet maxNodes. Wielomian (postać Newtona)
+// oraz jego wartości we wszystkich punktach aktualizujemy przyrostowo,
+// więc jeden krok kosztuje O(m + k).
+AdaptiveNodes selectNodesAdaptive(const vector<double>& xs, const vector<double>& ys,
+                                  double targetMSE, int maxNodes, int initialNodes = 3) {
+    AdaptiveNodes result{{}, 0.0};
+    int m = xs.size();
+    maxNodes = min(maxNodes, m - 1); // co najmniej jeden punkt poza węzłami
+    if (m == 0 || maxNodes <= 0) return result;
+
+    double x_min = *min_element(xs.begin(), xs.end());
+    double x_max = *max_element(xs.begin(), xs.end());
+    IncrementalNewton newton(x_min, x_max);
+    vector<double> local(m), value(m, 0.0), product(m, 1.0);
+    vector<char> isNode(m, 0);
+    for (int i = 0; i < m; i++) local[i] = newton.toLocal(xs[i]);
+
+    // Dodaje węzeł i zwraca indeks punktu o największym residuum (oraz MSE).
+    auto insert = [&](int idx, int& worst) {
+        double c = newton.addNode(xs[idx], ys[idx]);
+        double t = newton.localNodes().back();
+        isNode[idx] = 1;
+        result.indices.push_back(idx);
+        double errorSum = 0.0, worstError = -1.0;
+        int count = 0;
+        worst = -1;
+        for (int i = 0; i < m; i++) {
+            value[i] += c * product[i];
+            product[i] *= (local[i] - t);
+            if (isNode[i]) continue;
+            double diff = fabs(value[i] - ys[i]);
             errorSum += diff * diff;
             count++;
+            if (diff > worstError) {
+                worstError = diff;
+                worst = i;
+            }
+        }
+        return (count > 0) ? errorSum / count : 0.0;
+    };
+
+    int worst = -1;
+    vector<int> start = nestedNodeOrder(m);
+    start.resize(min<int>(max(initialNodes, 1), maxNodes));
+    for (int idx : start) result.mse = insert(idx, worst);
+    // MSE nie musi maleć monotonicznie, więc pamiętamy najlepszy prefiks.
+    size_t bestCount = result.indices.size();
+    double bestMSE = result.mse;
+    while (static_cast<int>(result.indices.size()) < maxNodes && result.mse > targetMSE && worst >= 0) {
+        result.mse = insert(worst, worst);
+        if (result.mse < bestMSE) {
+            bestMSE = result.mse;
+            bestCount = result.indices.size();
         }
     }
-    return (count > 0) ? errorSum / count : 0.0;
+    if (result.mse > targetMSE) {
+        result.indices.resize(bestCount);
+        result.mse = bestMSE;
+    }
+    return result;
 }
 
 int main() {
@@ -108,7 +467,8 @@ int main() {
     double x_input;
     cout << "Podaj wartość x, dla której chcesz obliczyć interpolację: ";
     cin >> x_input;
-    double interpValue = lagrangeInterpolation(nodes, nodeValues, x_input);
+    BarycentricInterpolator interpolator(nodes, nodeValues);
+    double interpValue = interpolator(x_input);
     cout << "Interpolowana wartość w punkcie x = " << x_input << " wynosi: " << interpValue << endl;
 
     // Obliczenie średniego błędu kwadratowego (MSE) dla punktów spoza węzłów.
@@ -127,10 +487,13 @@ int main() {
     double x_max = xs.back();
     int numPoints = 1000;
     double dx = (x_max - x_min) / (numPoints - 1);
+    vector<double> gridX(numPoints), gridY(numPoints);
+    for (int i = 0; i < numPoints; i++) {
+        gridX[i] = x_min + i * dx;
+    }
+    interpolator.evaluate(gridX.data(), gridY.data(), numPoints);
     for (int i = 0; i < numPoints; i++) {
-        double x_val = x_min + i * dx;
-        double y_val = lagrangeInterpolation(nodes, nodeValues, x_val);
-        outfile << x_val << "," << y_val << endl;
+        outfile << gridX[i] << "," << gridY[i] << endl;
     }
     outfile.close();
     cout << "Wyniki interpolacji zapisane do pliku output.txt." << endl;
@@ -140,18 +503,18 @@ int main() {
     double bestMSE = numeric_limits<double>::max();
     int total = xs.size();
 
-    // Testujemy liczby węzłów od, powiedzmy, -9 do 10:
-    for (int numNodes = -9; numNodes <= 10; numNodes += 2) {
-        vector<double> nodes_temp, nodeValues_temp;
-        // Obliczamy krok, aby równomiernie wybrać numNodes węzłów z pełnego zbioru:
-        double indexStep = (total - 1) / static_cast<double>(numNodes - 1);
-        for (int i = 0; i < numNodes; i++) {
-            int idx = static_cast<int>(i * indexStep + 0.5); // zaokrąglenie do najbliższego indeksu
-            if (idx >= total) idx = total - 1;
-            nodes_temp.push_back(xs[idx]);
-            nodeValues_temp.push_back(ys[idx]);
-        }
-        double mse_temp = computeMSE(xs, ys, nodes_temp, nodeValues_temp);
+    // Przegląd liczby węzłów: zbiory węzłów są zagnieżdżone (kolejne węzły
+    // dokładamy do poprzednich), więc MSE liczymy jednym przyrostowym
+    // przebiegiem. Porównujemy tylko pełne poziomy (2, 3, 5, 9, ... węzłów),
+    // bo tylko one są równomiernie rozłożone. Co najmniej jeden punkt musi
+    // zostać poza węzłami.
+    vector<int> levelEnds;
+    vector<int> order = nestedNodeOrder(total, &levelEnds);
+    if (static_cast<int>(order.size()) > total - 1) order.resize(max(total - 1, 0));
+    vector<double> sweepMSE = sweepNodeCounts(xs, ys, order);
+    for (int numNodes : levelEnds) {
+        if (numNodes > static_cast<int>(order.size())) break;
+        double mse_temp = sweepMSE[numNodes];
         cout << "Liczba węzłów: " << numNodes << " - MSE: " << mse_temp << endl;
         if (mse_temp < bestMSE) {
             bestMSE = mse_temp;
@@ -161,5 +524,11 @@ int main() {
 
     cout << "Najmniejszy błąd osiągamy dla " << bestNodes << " węzłów, MSE = " << bestMSE << endl;
 
+    // Adaptacyjny dobór węzłów: ile węzłów wystarcza do osiągnięcia MSE
+    // wyboru co 'step' punkt.
+    AdaptiveNodes adaptive = selectNodesAdaptive(xs, ys, mse, total - 1);
+    cout << "Dobór adaptacyjny: " << adaptive.indices.size() << " węzłów (zamiast " << nodes.size()
+         << "), MSE = " << adaptive.mse << endl;
+
     return 0;
 }
@@ -2,9 +2,13 @@
 #include <fstream>
 #include <sstream>
 #include <cmath>
-#include <ctime>
+#include <chrono>
+#include <random>
+#include <iomanip>
 #include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <immintrin.h>
 std::vector<double> load_H_data(const std::string& filename, std::vector<double>& x_points) {
     std::ifstream file(filename);
     std::vector<double> coefficients;
@@ -29,8 +33,10 @@ std::vector<double> load_H_data(const std::string& filename, std::vector<double>
 
 double natural_form(const std::vector<double>& a, double x) {
     double result = 0.0;
+    double power = 1.0;
     for (size_t i = 0; i < a.size(); ++i) {
-        result += a[i] * std::pow(x, i);
+        result += a[i] * power;
+        power *= x;
     }
     return result;
 }
@@ -43,55 +49,480 @@ double horner(const std::vector<double>& a, double x) {
     return result;
 }
 
+// Horner drugiego rzędu: p(x) = E(x^2) + x * O(x^2), dwa niezależne łańcuchy
+// liczone w jednej pętli
+double horner_second_order(const std::vector<double>& a, double x) {
+    size_t n = a.size();
+    if (n < 2) return n ? a[0] : 0.0;
+    double x2 = x * x;
+    size_t i = n;
+    double even = 0.0, odd = 0.0;
+    if (n % 2 == 1) even = a[--i]; // najwyższy współczynnik ma parzysty indeks
+    for (; i >= 2; i -= 2) {
+        odd = odd * x2 + a[i - 1];
+        even = even * x2 + a[i - 2];
+    }
+    return even + x * odd;
+}
+
+// Schemat Estrina w blokach po 8 współczynników (drzewo głębokości 3),
+// bloki łączone Hornerem w x^8. Wewnątrz bloku mnożenia są niezależne,
+// więc procesor może je wykonywać równolegle.
+double estrin(const std::vector<double>& a, double x) {
+    size_t n = a.size();
+    double x2 = x * x;
+    double x4 = x2 * x2;
+    double x8 = x4 * x4;
+    size_t full = n / 8 * 8;
+    double result = 0.0;
+    // niepełny blok na końcu (najwyższe potęgi)
+    for (size_t i = n; i > full; --i) result = result * x + a[i - 1];
+    for (size_t b = full; b > 0; b -= 8) {
+        const double* c = &a[b - 8];
+        double p01 = c[0] + c[1] * x;
+        double p23 = c[2] + c[3] * x;
+        double p45 = c[4] + c[5] * x;
+        double p67 = c[6] + c[7] * x;
+        double p03 = p01 + p23 * x2;
+        double p47 = p45 + p67 * x2;
+        result = result * x8 + (p03 + p47 * x4);
+    }
+    return result;
+}
+
+// Wyniki pomiarów trafiają tutaj, a argument czytany jest z volatile,
+// żeby kompilator nie usunął ani nie wyciągnął obliczeń przed pętlę
+static volatile double benchmark_sink;
+static volatile double benchmark_input;
+
+// Pomiar czasu pojedynczej metody: średni czas na jedno obliczenie [ns]
+template <typename Eval>
+static double time_per_eval(Eval eval, size_t evals_per_call) {
+    size_t reps = 1;
+    while (true) {
+        auto start = std::chrono::steady_clock::now();
+        double sum = 0.0;
+        for (size_t r = 0; r < reps; ++r) sum += eval();
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        benchmark_sink = sum;
+        if (elapsed > 2e7 || reps > (size_t(1) << 24)) return elapsed / (reps * evals_per_call);
+        reps *= 2;
+    }
+}
+
 void compare_methods(const std::vector<double>& a, double x) {
-    clock_t start = clock();
+    benchmark_input = x;
     double natural_result = natural_form(a, x);
-    double natural_time = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
-
-    start = clock();
+    double natural_time = time_per_eval([&] { return natural_form(a, benchmark_input); }, 1);
     double horner_result = horner(a, x);
-    double horner_time = static_cast<double>(clock() - start) / CLOCKS_PER_SEC;
+    double horner_time = time_per_eval([&] { return horner(a, benchmark_input); }, 1);
+    double horner2_result = horner_second_order(a, x);
+    double horner2_time = time_per_eval([&] { return horner_second_order(a, benchmark_input); }, 1);
+    double estrin_result = estrin(a, x);
+    double estrin_time = time_per_eval([&] { return estrin(a, benchmark_input); }, 1);
 
     std::cout << "Porównanie metod:\n"
-              << "Naturalna: " << natural_result << " (" << natural_time << "s)\n"
-              << "Horner:    " << horner_result << " (" << horner_time << "s)\n";
+              << "Naturalna: " << natural_result << " (" << natural_time << " ns)\n"
+              << "Horner:    " << horner_result << " (" << horner_time << " ns)\n"
+              << "Horner 2:  " << horner2_result << " (" << horner2_time << " ns)\n"
+              << "Estrin:    " << estrin_result << " (" << estrin_time << " ns)\n";
 }
 
-std::vector<std::vector<double>> compute_divided_differences(const std::vector<double>& xi, const std::vector<double>& fxi) {
-    size_t n = xi.size();
-    std::vector<std::vector<double>> table(n, std::vector<double>(n));
+// Przegląd stopni wielomianu: czas na jedno obliczenie [ns] dla metody
+// naturalnej, Hornera, Hornera drugiego rzędu, Estrina i wsadowego Hornera
+// SIMD (num_points punktów naraz).
+void benchmark_degree_sweep(size_t max_degree, size_t num_points) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> xs(num_points), out(num_points);
+    for (double& x : xs) x = dist(gen);
+
+    std::streamsize old_precision = std::cout.precision();
+    std::cout << std::setw(8) << "stopien" << std::setw(12) << "naturalna" << std::setw(12) << "horner"
+              << std::setw(12) << "horner2" << std::setw(12) << "estrin" << std::setw(12) << "simd" << "\n";
+    for (size_t degree = 1; degree <= max_degree; degree *= 2) {
+        std::vector<double> a(degree + 1);
+        for (double& c : a) c = dist(gen) / (degree + 1);
+        auto sweep = [&](double (*eval)(const std::vector<double>&, double)) {
+            return time_per_eval([&] {
+                double sum = 0.0;
+                for (double x : xs) sum += eval(a, x);
+                return sum;
+            }, xs.size());
+        };
+        double t_natural = sweep(natural_form);
+        double t_horner = sweep(horner);
+        double t_horner2 = sweep(horner_second_order);
+        double t_estrin = sweep(estrin);
+        double t_simd = time_per_eval([&] {
+            horner_batch(a, xs.data(), out.data(), xs.size());
+            return out[0];
+        }, xs.size());
+        std::cout << std::setw(8) << degree << std::fixed << std::setprecision(2)
+                  << std::setw(12) << t_natural << std::setw(12) << t_horner << std::setw(12) << t_horner2
+                  << std::setw(12) << t_estrin << std::setw(12) << t_simd << "\n" << std::defaultfloat;
+    }
+    std::cout.precision(old_precision);
+}
 
-    for (size_t i = 0; i < n; ++i) table[i][0] = fxi[i];
+// Tablicę ilorazów różnicowych liczymy kolumna po kolumnie w jednym wektorze:
+// po kroku j elementy c[j..n-1] zawierają f[x_{i-j}, ..., x_i], a c[0..j-1]
+// są już gotowymi współczynnikami.
+std::vector<double> compute_divided_differences(const std::vector<double>& xi, const std::vector<double>& fxi) {
+    size_t n = xi.size();
+    std::vector<double> c(fxi.begin(), fxi.begin() + n);
     for (size_t j = 1; j < n; ++j) {
-        for (size_t i = 0; i < n - j; ++i) {
-            table[i][j] = (table[i + 1][j - 1] - table[i][j - 1]) / (xi[i + j] - xi[i]);
+        for (size_t i = n - 1; i >= j; --i) {
+            c[i] = (c[i] - c[i - 1]) / (xi[i] - xi[i - j]);
         }
     }
-    return table;
+    return c;
 }
 
-double newton_polynomial(const std::vector<double>& xi, const std::vector<std::vector<double>>& diffs, double x) {
-    double result = diffs[0][0];
-    double product = 1.0;
-    for (size_t i = 1; i < xi.size(); ++i) {
-        product *= (x - xi[i - 1]);
-        result += diffs[0][i] * product;
+// Zagnieżdżona postać Newtona (jak schemat Hornera)
+double newton_polynomial(const std::vector<double>& xi, const std::vector<double>& coeffs, double x) {
+    size_t n = coeffs.size();
+    double result = coeffs[n - 1];
+    for (size_t i = n - 1; i-- > 0;) {
+        result = result * (x - xi[i]) + coeffs[i];
     }
     return result;
 }
 
-void generate_plot_data(const std::vector<double>& xi, const std::vector<std::vector<double>>& diffs, const std::string& filename) {
+// ---- Interpolator strumieniowy ----
+
+OnlineNewtonInterpolator::OnlineNewtonInterpolator(size_t max_nodes) : max_nodes_(max_nodes) {}
+
+void OnlineNewtonInterpolator::append(double x, double y) {
+    if (max_nodes_ > 0 && nodes_.size() == max_nodes_) drop_oldest();
+    size_t n = nodes_.size();
+    double carry = y;
+    for (size_t j = 0; j < n; ++j) {
+        double old = diagonal_[j];
+        diagonal_[j] = carry;
+        carry = (carry - old) / (x - nodes_[n - 1 - j]);
+    }
+    diagonal_.push_back(carry);
+    nodes_.push_back(x);
+    coeffs_.push_back(carry);
+}
+
+// Z f[x_0..x_{k+1}] = (f[x_1..x_{k+1}] - f[x_0..x_k]) / (x_{k+1} - x_0) dostajemy
+// współczynniki dla węzłów x_1..x_{n-1}; przekątna d_j dla j < n-1 nie zależy od x_0.
+void OnlineNewtonInterpolator::drop_oldest() {
+    size_t n = nodes_.size();
+    if (n == 0) return;
+    for (size_t k = 0; k + 1 < n; ++k) {
+        coeffs_[k] += coeffs_[k + 1] * (nodes_[k + 1] - nodes_[0]);
+    }
+    coeffs_.pop_back();
+    diagonal_.pop_back();
+    nodes_.erase(nodes_.begin());
+}
+
+double OnlineNewtonInterpolator::operator()(double x) const {
+    if (coeffs_.empty()) return 0.0;
+    return newton_polynomial(nodes_, coeffs_, x);
+}
+
+// ---- Obliczanie wsadowe ----
+// Każde jądro trzyma kilka wektorów x jednocześnie w locie, żeby ukryć
+// opóźnienie FMA w łańcuchu zależności Hornera.
+
+static void horner_batch_scalar(const double* a, size_t n, const double* x, double* out, size_t count) {
+    for (size_t k = 0; k < count; ++k) {
+        double result = a[n - 1];
+        for (size_t i = n - 1; i-- > 0;) {
+            result = result * x[k] + a[i];
+        }
+        out[k] = result;
+    }
+}
+
+static void newton_batch_scalar(const double* xi, const double* c, size_t n, const double* x, double* out, size_t count) {
+    for (size_t k = 0; k < count; ++k) {
+        double result = c[n - 1];
+        for (size_t i = n - 1; i-- > 0;) {
+            result = result * (x[k] - xi[i]) + c[i];
+        }
+        out[k] = result;
+    }
+}
+
+__attribute__((target("avx2,fma")))
+static void horner_batch_avx2(const double* a, size_t n, const double* x, double* out, size_t count) {
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256d x0 = _mm256_loadu_pd(x + k);
+        __m256d x1 = _mm256_loadu_pd(x + k + 4);
+        __m256d r0 = _mm256_set1_pd(a[n - 1]);
+        __m256d r1 = r0;
+        for (size_t i = n - 1; i-- > 0;) {
+            __m256d ai = _mm256_set1_pd(a[i]);
+            r0 = _mm256_fmadd_pd(r0, x0, ai);
+            r1 = _mm256_fmadd_pd(r1, x1, ai);
+        }
+        _mm256_storeu_pd(out + k, r0);
+        _mm256_storeu_pd(out + k + 4, r1);
+    }
+    horner_batch_scalar(a, n, x + k, out + k, count - k);
+}
+
+__attribute__((target("avx2,fma")))
+static void newton_batch_avx2(const double* xi, const double* c, size_t n, const double* x, double* out, size_t count) {
+    size_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256d x0 = _mm256_loadu_pd(x + k);
+        __m256d x1 = _mm256_loadu_pd(x + k + 4);
+        __m256d r0 = _mm256_set1_pd(c[n - 1]);
+        __m256d r1 = r0;
+        for (size_t i = n - 1; i-- > 0;) {
+            __m256d node = _mm256_set1_pd(xi[i]);
+            __m256d ci = _mm256_set1_pd(c[i]);
+            r0 = _mm256_fmadd_pd(r0, _mm256_sub_pd(x0, node), ci);
+            r1 = _mm256_fmadd_pd(r1, _mm256_sub_pd(x1, node), ci);
+        }
+        _mm256_storeu_pd(out + k, r0);
+        _mm256_storeu_pd(out + k + 4, r1);
+    }
+    newton_batch_scalar(xi, c, n, x + k, out + k, count - k);
+}
+
+__attribute__((target("avx512f")))
+static void horner_batch_avx512(const double* a, size_t n, const double* x, double* out, size_t count) {
+    size_t k = 0;
+    for (; k + 16 <= count; k += 16) {
+        __m512d x0 = _mm512_loadu_pd(x + k);
+        __m512d x1 = _mm512_loadu_pd(x + k + 8);
+        __m512d r0 = _mm512_set1_pd(a[n - 1]);
+        __m512d r1 = r0;
+        for (size_t i = n - 1; i-- > 0;) {
+            __m512d ai = _mm512_set1_pd(a[i]);
+            r0 = _mm512_fmadd_pd(r0, x0, ai);
+            r1 = _mm512_fmadd_pd(r1, x1, ai);
+        }
+        _mm512_storeu_pd(out + k, r0);
+        _mm512_storeu_pd(out + k + 8, r1);
+    }
+    horner_batch_avx2(a, n, x + k, out + k, count - k);
+}
+
+__attribute__((target("avx512f")))
+static void newton_batch_avx512(const double* xi, const double* c, size_t n, const double* x, double* out, size_t count) {
+    size_t k = 0;
+    for (; k + 16 <= count; k += 16) {
+        __m512d x0 = _mm512_loadu_pd(x + k);
+        __m512d x1 = _mm512_loadu_pd(x + k + 8);
+        __m512d r0 = _mm512_set1_pd(c[n - 1]);
+        __m512d r1 = r0;
+        for (size_t i = n - 1; i-- > 0;) {
+            __m512d node = _mm512_set1_pd(xi[i]);
+            __m512d ci = _mm512_set1_pd(c[i]);
+            r0 = _mm512_fmadd_pd(r0, _mm512_sub_pd(x0, node), ci);
+            r1 = _mm512_fmadd_pd(r1, _mm512_sub_pd(x1, node), ci);
+        }
+        _mm512_storeu_pd(out + k, r0);
+        _mm512_storeu_pd(out + k + 8, r1);
+    }
+    newton_batch_avx2(xi, c, n, x + k, out + k, count - k);
+}
+
+static int simd_level() {
+    static const int level = __builtin_cpu_supports("avx512f") ? 2
+                           : (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) ? 1 : 0;
+    return level;
+}
+
+void horner_batch(const std::vector<double>& a, const double* x, double* out, size_t count) {
+    if (a.empty()) {
+        std::fill(out, out + count, 0.0);
+        return;
+    }
+    switch (simd_level()) {
+        case 2: horner_batch_avx512(a.data(), a.size(), x, out, count); break;
+        case 1: horner_batch_avx2(a.data(), a.size(), x, out, count); break;
+        default: horner_batch_scalar(a.data(), a.size(), x, out, count); break;
+    }
+}
+
+void newton_polynomial_batch(const std::vector<double>& xi, const std::vector<double>& coeffs,
+                             const double* x, double* out, size_t count) {
+    if (coeffs.empty()) {
+        std::fill(out, out + count, 0.0);
+        return;
+    }
+    // stopień z liczby współczynników, jak w newton_polynomial; potrzebne
+    // są węzły x_0 ... x_{n-2}
+    size_t n = coeffs.size();
+    if (xi.size() + 1 < n) {
+        throw std::invalid_argument("newton_polynomial_batch: za mało węzłów dla podanych współczynników");
+    }
+    const double* c = coeffs.data();
+    switch (simd_level()) {
+        case 2: newton_batch_avx512(xi.data(), c, n, x, out, count); break;
+        case 1: newton_batch_avx2(xi.data(), c, n, x, out, count); break;
+        default: newton_batch_scalar(xi.data(), c, n, x, out, count); break;
+    }
+}
+
+void generate_plot_data(const std::vector<double>& xi, const std::vector<double>& coeffs, const std::string& filename) {
     std::ofstream file(filename);
     double x_start = *std::min_element(xi.begin(), xi.end());
     double x_end = *std::max_element(xi.begin(), xi.end());
-    for (double x = x_start; x <= x_end; x += 0.1) {
-        file << x << "," << newton_polynomial(xi, diffs, x) << "\n";
+    std::vector<double> xs;
+    for (double x = x_start; x <= x_end; x += 0.1) xs.push_back(x);
+    std::vector<double> ys(xs.size());
+    newton_polynomial_batch(xi, coeffs, xs.data(), ys.data(), xs.size());
+    for (size_t k = 0; k < xs.size(); ++k) {
+        file << xs[k] << "," << ys[k] << "\n";
     }
 }
 
 void generate_horner_plot_data(const std::vector<double>& a, const std::vector<double>& x_range, const std::string& filename) {
     std::ofstream file(filename);
-    for (double x : x_range) {
-        file << x << "," << horner(a, x) << "\n";
+    std::vector<double> ys(x_range.size());
+    horner_batch(a, x_range.data(), ys.data(), x_range.size());
+    for (size_t k = 0; k < x_range.size(); ++k) {
+        file << x_range[k] << "," << ys[k] << "\n";
+    }
+}
+
+// ---- Interpolacja Czebyszewa ----
+
+void fft(std::vector<std::complex<double>>& data, bool inverse) {
+    size_t n = data.size();
+    if (n & (n - 1)) throw std::invalid_argument("fft: rozmiar musi być potęgą dwójki");
+    for (size_t i = 1, j = 0; i < n; ++i) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(data[i], data[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        double angle = 2.0 * M_PI / len * (inverse ? 1 : -1);
+        std::complex<double> step(std::cos(angle), std::sin(angle));
+        for (size_t i = 0; i < n; i += len) {
+            std::complex<double> w(1.0);
+            for (size_t k = 0; k < len / 2; ++k) {
+                std::complex<double> u = data[i + k];
+                std::complex<double> v = data[i + k + len / 2] * w;
+                data[i + k] = u + v;
+                data[i + k + len / 2] = u - v;
+                w *= step;
+            }
+        }
+    }
+    if (inverse) {
+        for (auto& value : data) value /= static_cast<double>(n);
+    }
+}
+
+// Punkty x_j = cos(pi * j / (n - 1)), j = 0..n-1, przeniesione na [a, b]
+std::vector<double> chebyshev_points(size_t n, double a, double b) {
+    std::vector<double> points(n);
+    if (n == 1) {
+        points[0] = 0.5 * (a + b);
+        return points;
+    }
+    for (size_t j = 0; j < n; ++j) {
+        points[j] = 0.5 * (a + b) + 0.5 * (b - a) * std::cos(M_PI * j / (n - 1));
+    }
+    return points;
+}
+
+// Współczynniki z wartości w punktach Czebyszewa przez DCT-I: FFT
+// parzystego przedłużenia długości 2(n-1), gdy n - 1 jest potęgą dwójki,
+// w przeciwnym razie sumy liczone wprost w O(n^2).
+ChebyshevInterpolant chebyshev_from_values(const std::vector<double>& values, double a, double b) {
+    ChebyshevInterpolant p{a, b, {}};
+    size_t n = values.size();
+    if (n <= 1) {
+        p.coeffs = values;
+        return p;
+    }
+    size_t N = n - 1;
+    p.coeffs.resize(n);
+    if (N & (N - 1)) {
+        for (size_t k = 0; k <= N; ++k) {
+            double sum = values[0] + (k % 2 ? -values[N] : values[N]);
+            for (size_t j = 1; j < N; ++j) {
+                // cos(pi jk / N) z argumentem zredukowanym modulo 2N
+                sum += 2.0 * values[j] * std::cos(M_PI * static_cast<double>(j * k % (2 * N)) / N);
+            }
+            p.coeffs[k] = sum / N;
+        }
+    } else {
+        std::vector<std::complex<double>> ext(2 * N);
+        for (size_t j = 0; j <= N; ++j) ext[j] = values[j];
+        for (size_t j = 1; j < N; ++j) ext[2 * N - j] = values[j];
+        fft(ext);
+        for (size_t k = 0; k <= N; ++k) p.coeffs[k] = ext[k].real() / N;
+    }
+    p.coeffs[0] *= 0.5;
+    p.coeffs[N] *= 0.5;
+    return p;
+}
+
+// Skala błędu zaokrągleń: sum |c_k| ogranicza max |p(x)| z góry
+static double chebyshev_scale(const std::vector<double>& coeffs) {
+    double scale = 0.0;
+    for (double c : coeffs) scale += std::fabs(c);
+    return scale;
+}
+
+// Obcina końcowe współczynniki mniejsze niż tol * sum |c_k|
+void chebyshev_truncate(ChebyshevInterpolant& p, double tol) {
+    double scale = chebyshev_scale(p.coeffs);
+    size_t keep = p.coeffs.size();
+    while (keep > 1 && std::fabs(p.coeffs[keep - 1]) <= tol * scale) --keep;
+    p.coeffs.resize(keep);
+}
+
+// Próbkowanie na coraz gęstszej siatce (17, 33, 65, ... punktów; stare
+// punkty są podzbiorem nowych, więc liczymy f tylko w nowych), aż kilka
+// ostatnich współczynników spadnie poniżej tolerancji.
+ChebyshevInterpolant chebyshev_fit(const std::function<double(double)>& f, double a, double b,
+                                   double tol, size_t max_n) {
+    size_t N = 16;
+    std::vector<double> values(N + 1);
+    std::vector<double> points = chebyshev_points(N + 1, a, b);
+    for (size_t j = 0; j <= N; ++j) values[j] = f(points[j]);
+
+    while (true) {
+        ChebyshevInterpolant p = chebyshev_from_values(values, a, b);
+        double scale = chebyshev_scale(p.coeffs);
+        size_t tail = std::max<size_t>(2, N / 8);
+        bool converged = true;
+        for (size_t k = N + 1 - tail; k <= N; ++k) {
+            if (std::fabs(p.coeffs[k]) > tol * scale) {
+                converged = false;
+                break;
+            }
+        }
+        if (converged || 2 * N + 1 > max_n) {
+            chebyshev_truncate(p, tol);
+            return p;
+        }
+
+        std::vector<double> refined(2 * N + 1);
+        points = chebyshev_points(2 * N + 1, a, b);
+        for (size_t j = 0; j <= 2 * N; ++j) {
+            refined[j] = (j % 2 == 0) ? values[j / 2] : f(points[j]);
+        }
+        values.swap(refined);
+        N *= 2;
+    }
+}
+
+// Schemat Clenshawa
+double chebyshev_eval(const ChebyshevInterpolant& p, double x) {
+    if (p.coeffs.empty()) return 0.0;
+    double t = (2.0 * x - p.a - p.b) / (p.b - p.a);
+    double b1 = 0.0, b2 = 0.0;
+    for (size_t k = p.coeffs.size() - 1; k > 0; --k) {
+        double b0 = p.coeffs[k] + 2.0 * t * b1 - b2;
+        b2 = b1;
+        b1 = b0;
     }
+    return p.coeffs[0] + t * b1 - b2;
 }
\ No newline at end of file
@@ -4,17 +4,66 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <complex>
+#include <functional>
 
 // Zadania 1-4
 std::vector<double> load_H_data(const std::string& filename, std::vector<double>& x_points);
 double natural_form(const std::vector<double>& a, double x);
 double horner(const std::vector<double>& a, double x);
+double horner_second_order(const std::vector<double>& a, double x);
+double estrin(const std::vector<double>& a, double x);
 void compare_methods(const std::vector<double>& a, double x);
+void benchmark_degree_sweep(size_t max_degree, size_t num_points);
 
 // Zadanie 5
-std::vector<std::vector<double>> compute_divided_differences(const std::vector<double>& xi, const std::vector<double>& fxi);
-double newton_polynomial(const std::vector<double>& xi, const std::vector<std::vector<double>>& diffs, double x);
-void generate_plot_data(const std::vector<double>& xi, const std::vector<std::vector<double>>& diffs, const std::string& filename);
+// Współczynniki postaci Newtona c_k = f[x_0, ..., x_k] (pamięć O(n))
+std::vector<double> compute_divided_differences(const std::vector<double>& xi, const std::vector<double>& fxi);
+double newton_polynomial(const std::vector<double>& xi, const std::vector<double>& coeffs, double x);
+void generate_plot_data(const std::vector<double>& xi, const std::vector<double>& coeffs, const std::string& filename);
 void generate_horner_plot_data(const std::vector<double>& a, const std::vector<double>& x_range, const std::string& filename);
 
+// Obliczanie wartości dla całej tablicy x naraz (out[k] = p(x[k])).
+// Jądra AVX2/AVX-512 wybierane w trakcie działania, skalarna ścieżka zapasowa.
+void horner_batch(const std::vector<double>& a, const double* x, double* out, size_t count);
+void newton_polynomial_batch(const std::vector<double>& xi, const std::vector<double>& coeffs,
+                             const double* x, double* out, size_t count);
+
+// Interpolator Newtona z dopisywaniem punktów: append() rozszerza przekątną
+// tablicy ilorazów różnicowych w O(n), wartości są poprawne po każdym kroku.
+// Przy max_nodes > 0 najstarsze węzły są usuwane (też w O(n)).
+class OnlineNewtonInterpolator {
+public:
+    explicit OnlineNewtonInterpolator(size_t max_nodes = 0);
+    void append(double x, double y);
+    double operator()(double x) const;
+    size_t size() const { return nodes_.size(); }
+    const std::vector<double>& nodes() const { return nodes_; }
+    const std::vector<double>& coefficients() const { return coeffs_; }
+
+private:
+    void drop_oldest();
+
+    size_t max_nodes_;
+    std::vector<double> nodes_;    // x_0 (najstarszy) ... x_{n-1}
+    std::vector<double> coeffs_;   // c_k = f[x_0, ..., x_k]
+    std::vector<double> diagonal_; // d_j = f[x_{n-1-j}, ..., x_{n-1}]
+};
+
+// Interpolacja w punktach Czebyszewa (drugiego rodzaju) na [a, b].
+// p(x) = sum_k coeffs[k] * T_k(t), t = (2x - a - b) / (b - a)
+struct ChebyshevInterpolant {
+    double a, b;
+    std::vector<double> coeffs;
+};
+std::vector<double> chebyshev_points(size_t n, double a, double b);
+ChebyshevInterpolant chebyshev_from_values(const std::vector<double>& values, double a, double b);
+ChebyshevInterpolant chebyshev_fit(const std::function<double(double)>& f, double a, double b,
+                                   double tol = 1e-14, size_t max_n = size_t(1) << 20);
+void chebyshev_truncate(ChebyshevInterpolant& p, double tol);
+double chebyshev_eval(const ChebyshevInterpolant& p, double x);
+
+// FFT radix-2 w miejscu; rozmiar inny niż potęga dwójki -> std::invalid_argument
+void fft(std::vector<std::complex<double>>& data, bool inverse = false);
+
 #endif
\ No newline at end of file
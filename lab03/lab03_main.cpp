@@ -4,6 +4,7 @@
 #include <sstream>
 #include <string>
 #include "interpolation.h"
+#include "spline.h"
 
 void load_N_data(const std::string& filename, std::vector<double>& xi, std::vector<double>& fxi) {
     std::ifstream file(filename);
@@ -19,7 +20,14 @@ void load_N_data(const std::string& filename, std::vector<double>& xi, std::vect
     while (ss_fxi >> val) fxi.push_back(val);
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Tryb pomiarowy: porównanie metod obliczania wielomianu w funkcji stopnia
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        benchmark_degree_sweep(1024, 4096);
+        benchmark_spline(1000, 10000000);
+        return 0;
+    }
+
     // Zadania 1-4
     std::vector<double> x_points_H;
     std::vector<double> a = load_H_data("interpolacja_H_gr_03.txt", x_points_H);
@@ -53,14 +61,31 @@ for (const auto& pair : paired_data) {
     selected_fxi.push_back(pair.second);
 }
 
-    auto diffs = compute_divided_differences(selected_xi, selected_fxi);
-    generate_plot_data(selected_xi, diffs, "plot_data.csv");
+    std::vector<double> coeffs = compute_divided_differences(selected_xi, selected_fxi);
+    generate_plot_data(selected_xi, coeffs, "plot_data.csv");
 
     // Zadanie 6
     std::cout << "Podaj x: ";
     double user_x;
     std::cin >> user_x;
-    std::cout << "Wartosc: " << newton_polynomial(selected_xi, diffs, user_x) << "\n";
+    std::cout << "Wartosc: " << newton_polynomial(selected_xi, coeffs, user_x) << "\n";
+
+    // Te same węzły podawane po kolei, bez przebudowy tablicy ilorazów
+    OnlineNewtonInterpolator online;
+    for (size_t i = 0; i < selected_xi.size(); ++i) online.append(selected_xi[i], selected_fxi[i]);
+    std::cout << "Wartosc (strumieniowo): " << online(user_x) << "\n";
+
+    // Funkcja sklejana przez wszystkie punkty (posortowane)
+    std::vector<std::pair<double, double>> all_points;
+    for (size_t i = 0; i < xi_N.size(); ++i) all_points.emplace_back(xi_N[i], fxi_N[i]);
+    std::sort(all_points.begin(), all_points.end());
+    std::vector<double> spline_x, spline_y;
+    for (const auto& point : all_points) {
+        spline_x.push_back(point.first);
+        spline_y.push_back(point.second);
+    }
+    CubicSpline spline = build_cubic_spline(spline_x, spline_y);
+    std::cout << "Wartosc (funkcja sklejana): " << spline_eval(spline, user_x) << "\n";
 
     // Generowanie danych dla Hornera
     std::vector<double> x_range;
@@ -69,5 +94,11 @@ for (const auto& pair : paired_data) {
     for (double x = x_start; x <= x_end; x += 0.1) x_range.push_back(x);
     generate_horner_plot_data(a, x_range, "horner_data.csv");
 
+    // Interpolacja Czebyszewa funkcji Rungego (funkcję można próbkować dowolnie)
+    auto runge = [](double x) { return 1.0 / (1.0 + 25.0 * x * x); };
+    ChebyshevInterpolant cheb = chebyshev_fit(runge, -1.0, 1.0);
+    std::cout << "Czebyszew (funkcja Rungego): stopien " << cheb.coeffs.size() - 1
+              << ", p(0.3) = " << chebyshev_eval(cheb, 0.3) << ", f(0.3) = " << runge(0.3) << "\n";
+
     return 0;
 }
\ No newline at end of file
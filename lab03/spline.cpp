@@ -0,0 +1,148 @@
+#include "spline.h"
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <iostream>
+#include <algorithm>
+
+void solve_tridiagonal(const std::vector<double>& lower, std::vector<double> diag,
+                       const std::vector<double>& upper, std::vector<double>& rhs) {
+    size_t n = diag.size();
+    if (n == 0) return;
+    for (size_t i = 1; i < n; ++i) {
+        double m = lower[i] / diag[i - 1];
+        diag[i] -= m * upper[i - 1];
+        rhs[i] -= m * rhs[i - 1];
+    }
+    rhs[n - 1] /= diag[n - 1];
+    for (size_t i = n - 1; i-- > 0;) {
+        rhs[i] = (rhs[i] - upper[i] * rhs[i + 1]) / diag[i];
+    }
+}
+
+CubicSpline build_cubic_spline(const std::vector<double>& x, const std::vector<double>& y,
+                               SplineBoundary boundary, double dy0, double dyn) {
+    CubicSpline s;
+    size_t n = x.size();
+    s.x = x;
+    if (n < 2) {
+        s.a = y;
+        s.b.assign(n, 0.0);
+        s.c.assign(n, 0.0);
+        s.d.assign(n, 0.0);
+        return s;
+    }
+    size_t intervals = n - 1;
+    std::vector<double> h(intervals), slope(intervals);
+    for (size_t i = 0; i < intervals; ++i) {
+        h[i] = x[i + 1] - x[i];
+        slope[i] = (y[i + 1] - y[i]) / h[i];
+    }
+
+    // Układ na drugie pochodne M_i w węzłach
+    std::vector<double> lower(n, 0.0), diag(n, 1.0), upper(n, 0.0), m(n, 0.0);
+    for (size_t i = 1; i < intervals; ++i) {
+        lower[i] = h[i - 1];
+        diag[i] = 2.0 * (h[i - 1] + h[i]);
+        upper[i] = h[i];
+        m[i] = 6.0 * (slope[i] - slope[i - 1]);
+    }
+    if (boundary == SplineBoundary::Clamped) {
+        diag[0] = 2.0 * h[0];
+        upper[0] = h[0];
+        m[0] = 6.0 * (slope[0] - dy0);
+        lower[n - 1] = h[intervals - 1];
+        diag[n - 1] = 2.0 * h[intervals - 1];
+        m[n - 1] = 6.0 * (dyn - slope[intervals - 1]);
+    }
+    solve_tridiagonal(lower, diag, upper, m);
+
+    s.a.assign(y.begin(), y.begin() + intervals);
+    s.b.resize(intervals);
+    s.c.resize(intervals);
+    s.d.resize(intervals);
+    for (size_t i = 0; i < intervals; ++i) {
+        s.b[i] = slope[i] - h[i] * (2.0 * m[i] + m[i + 1]) / 6.0;
+        s.c[i] = 0.5 * m[i];
+        s.d[i] = (m[i + 1] - m[i]) / (6.0 * h[i]);
+    }
+
+    // Indeks z dzielenia przez średni krok jest błędny najwyżej o jeden
+    // (co poprawiają dwa porównania w find_interval), o ile każdy węzeł leży
+    // bliżej niż o jeden krok od swojego położenia na siatce równoodległej.
+    // Samo ograniczenie odchyleń pojedynczych kroków nie wystarcza, bo
+    // odchylenia się sumują.
+    double mean_h = (x[n - 1] - x[0]) / intervals;
+    double max_dev = 0.0;
+    for (size_t i = 1; i < intervals; ++i) {
+        max_dev = std::max(max_dev, std::fabs(x[i] - (x[0] + i * mean_h)));
+    }
+    s.uniform = max_dev < mean_h;
+    s.inv_h = 1.0 / mean_h;
+    return s;
+}
+
+// Indeks przedziału zawierającego x (skrajne przedziały dla x spoza zakresu)
+static inline size_t find_interval(const CubicSpline& s, double x) {
+    const double* nodes = s.x.data();
+    size_t intervals = s.x.size() - 1;
+    if (s.uniform) {
+        double guess = (x - nodes[0]) * s.inv_h;
+        guess = std::min(std::max(guess, 0.0), static_cast<double>(intervals - 1));
+        size_t i = static_cast<size_t>(guess);
+        i -= (i > 0 && x < nodes[i]);
+        i += (i + 1 < intervals && x >= nodes[i + 1]);
+        return i;
+    }
+    // Wyszukiwanie binarne bez skoków warunkowych (tylko wybór przesunięcia)
+    const double* base = nodes;
+    size_t len = intervals;
+    while (len > 1) {
+        size_t half = len / 2;
+        base += (base[half] <= x) ? half : 0;
+        len -= half;
+    }
+    return base - nodes;
+}
+
+static inline double eval_at(const CubicSpline& s, double x) {
+    size_t i = find_interval(s, x);
+    double t = x - s.x[i];
+    return s.a[i] + t * (s.b[i] + t * (s.c[i] + t * s.d[i]));
+}
+
+double spline_eval(const CubicSpline& s, double x) {
+    if (s.x.size() < 2) return s.a.empty() ? 0.0 : s.a[0];
+    return eval_at(s, x);
+}
+
+void spline_eval_batch(const CubicSpline& s, const double* x, double* out, size_t count) {
+    if (s.x.size() < 2) {
+        std::fill(out, out + count, s.a.empty() ? 0.0 : s.a[0]);
+        return;
+    }
+    for (size_t k = 0; k < count; ++k) out[k] = eval_at(s, x[k]);
+}
+
+// Liczba obliczeń na sekundę dla siatki równoodległej i nieregularnej
+void benchmark_spline(size_t num_nodes, size_t num_queries) {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<double> queries(num_queries), out(num_queries);
+    for (double& q : queries) q = dist(gen);
+
+    for (int irregular = 0; irregular <= 1; ++irregular) {
+        std::vector<double> x(num_nodes), y(num_nodes);
+        for (size_t i = 0; i < num_nodes; ++i) {
+            double t = static_cast<double>(i) / (num_nodes - 1);
+            x[i] = irregular ? t * t : t;
+            y[i] = std::sin(6.0 * x[i]);
+        }
+        CubicSpline s = build_cubic_spline(x, y);
+        auto start = std::chrono::steady_clock::now();
+        spline_eval_batch(s, queries.data(), out.data(), num_queries);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << (irregular ? "Siatka nieregularna: " : "Siatka rownoodlegla: ")
+                  << num_queries / seconds / 1e6 << " mln obliczen/s\n";
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef SPLINE_H
+#define SPLINE_H
+
+#include <vector>
+#include <cstddef>
+
+// Funkcja sklejana trzeciego stopnia. Na przedziale [x_i, x_{i+1}]:
+// s(x) = a_i + b_i t + c_i t^2 + d_i t^3, t = x - x_i.
+// Współczynniki trzymane są w osobnych tablicach (struktura tablic).
+enum class SplineBoundary { Natural, Clamped };
+
+struct CubicSpline {
+    std::vector<double> x, a, b, c, d;
+    bool uniform = false; // węzły (prawie) równoodległe: wyszukiwanie w O(1)
+    double inv_h = 0.0;
+};
+
+// Węzły muszą być rosnące. Dla Clamped dy0/dyn to pochodne na końcach.
+CubicSpline build_cubic_spline(const std::vector<double>& x, const std::vector<double>& y,
+                               SplineBoundary boundary = SplineBoundary::Natural,
+                               double dy0 = 0.0, double dyn = 0.0);
+double spline_eval(const CubicSpline& s, double x);
+void spline_eval_batch(const CubicSpline& s, const double* x, double* out, size_t count);
+
+// Algorytm Thomasa: lower[i] * u[i-1] + diag[i] * u[i] + upper[i] * u[i+1] = rhs[i]
+// (lower[0] i upper[n-1] są pomijane). Wynik zapisywany w rhs.
+void solve_tridiagonal(const std::vector<double>& lower, std::vector<double> diag,
+                       const std::vector<double>& upper, std::vector<double>& rhs);
+
+void benchmark_spline(size_t num_nodes, size_t num_queries);
+
+#endif
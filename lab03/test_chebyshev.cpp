@@ -0,0 +1,57 @@
+#include "interpolation.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+// Sprawdzenie chebyshev_from_values dla dowolnej liczby punktów: interpolant
+// musi odtwarzać wartości w węzłach, także gdy n - 1 nie jest potęgą dwójki
+// (wtedy DCT-I liczona jest wprost zamiast przez FFT).
+// Kompilacja: g++ -std=c++17 -O2 -mavx2 -mfma test_chebyshev.cpp interpolation.cpp -o test_chebyshev
+
+static bool check_size(size_t n) {
+    const double a = -2.0, b = 3.0;
+    std::vector<double> points = chebyshev_points(n, a, b);
+    std::vector<double> values(n);
+    for (size_t j = 0; j < n; ++j) values[j] = std::exp(0.5 * points[j]) * std::sin(points[j]);
+    ChebyshevInterpolant p = chebyshev_from_values(values, a, b);
+
+    double max_error = 0.0;
+    for (size_t j = 0; j < n; ++j) max_error = std::max(max_error, std::fabs(chebyshev_eval(p, points[j]) - values[j]));
+    bool ok = p.coeffs.size() == n && max_error <= 1e-12;
+    if (!ok) std::cout << "n = " << n << ": max blad w wezlach " << max_error << " BLAD\n";
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    for (size_t n = 1; n <= 70; ++n) ok &= check_size(n);
+    std::cout << "Wartosci w wezlach dla n = 1..70" << (ok ? " OK" : " BLAD") << "\n";
+
+    // Ta sama funkcja na 11 i 17 punktach: niskie współczynniki prawie równe
+    std::vector<double> v11(11), v17(17);
+    std::vector<double> x11 = chebyshev_points(11, -1.0, 1.0), x17 = chebyshev_points(17, -1.0, 1.0);
+    for (size_t j = 0; j < 11; ++j) v11[j] = 1.0 / (2.0 + x11[j]);
+    for (size_t j = 0; j < 17; ++j) v17[j] = 1.0 / (2.0 + x17[j]);
+    ChebyshevInterpolant p11 = chebyshev_from_values(v11, -1.0, 1.0);
+    ChebyshevInterpolant p17 = chebyshev_from_values(v17, -1.0, 1.0);
+    bool coeffs_ok = true;
+    for (size_t k = 0; k < 4; ++k) coeffs_ok &= std::fabs(p11.coeffs[k] - p17.coeffs[k]) <= 1e-5;
+    std::cout << "Wspolczynniki n = 11 i n = 17" << (coeffs_ok ? " OK" : " BLAD") << "\n";
+    ok &= coeffs_ok;
+
+    bool thrown = false;
+    std::vector<std::complex<double>> data(12);
+    try {
+        fft(data);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    std::cout << "fft dla rozmiaru 12 zglasza blad" << (thrown ? " OK" : " BLAD") << "\n";
+    ok &= thrown;
+
+    std::cout << (ok ? "Wszystkie testy zaliczone" : "Niektore testy nie przeszly") << "\n";
+    return ok ? 0 : 1;
+}
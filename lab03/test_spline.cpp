@@ -0,0 +1,71 @@
+#include "spline.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Sprawdzenie wyszukiwania przedziału w spline_eval: wynik porównywany jest
+// z wartością liczoną na przedziale wyznaczonym przez std::upper_bound.
+// Kompilacja: g++ -std=c++17 -O2 test_spline.cpp spline.cpp -o test_spline
+
+static double reference_eval(const CubicSpline& s, double x) {
+    size_t intervals = s.x.size() - 1;
+    size_t i = std::upper_bound(s.x.begin(), s.x.end(), x) - s.x.begin();
+    i = std::min(std::max(i, size_t(1)), intervals) - 1;
+    double t = x - s.x[i];
+    return s.a[i] + t * (s.b[i] + t * (s.c[i] + t * s.d[i]));
+}
+
+static bool check_grid(const std::string& name, const std::vector<double>& x) {
+    std::vector<double> y(x.size());
+    for (size_t i = 0; i < x.size(); ++i) y[i] = std::sin(0.1 * x[i]);
+    CubicSpline s = build_cubic_spline(x, y);
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(x.front() - 1.0, x.back() + 1.0);
+    std::vector<double> queries(x);
+    for (int k = 0; k < 100000; ++k) queries.push_back(dist(gen));
+
+    double max_error = 0.0;
+    for (double q : queries) max_error = std::max(max_error, std::fabs(spline_eval(s, q) - reference_eval(s, q)));
+    bool ok = max_error <= 1e-12;
+    std::cout << name << (s.uniform ? " (O(1)): " : " (binarne): ") << "max roznica " << max_error
+              << (ok ? " OK" : " BLAD") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    const size_t n = 201;
+
+    std::vector<double> uniform(n);
+    for (size_t i = 0; i < n; ++i) uniform[i] = 0.5 * i;
+    ok &= check_grid("Siatka rownoodlegla", uniform);
+
+    // Kroki 1.09 i 0.91 na przemian: każdy krok w granicach 10% średniego
+    std::vector<double> alternating(n);
+    for (size_t i = 1; i < n; ++i) alternating[i] = alternating[i - 1] + (i % 2 ? 1.09 : 0.91);
+    ok &= check_grid("Kroki 1.09 / 0.91 na przemian", alternating);
+
+    // Najpierw 100 kroków 1.09, potem 100 kroków 0.91: każdy krok w granicach
+    // 10%, ale środkowe węzły odchylają się o ~9 średnich kroków
+    std::vector<double> drifting(n);
+    for (size_t i = 1; i < n; ++i) drifting[i] = drifting[i - 1] + (i <= 100 ? 1.09 : 0.91);
+    ok &= check_grid("Kroki 1.09, potem 0.91", drifting);
+
+    // Losowe odchylenia kroku do 5%
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> jitter(0.95, 1.05);
+    std::vector<double> jittered(n);
+    for (size_t i = 1; i < n; ++i) jittered[i] = jittered[i - 1] + jitter(gen);
+    ok &= check_grid("Losowe kroki 0.95..1.05", jittered);
+
+    std::vector<double> squares(n);
+    for (size_t i = 0; i < n; ++i) squares[i] = double(i) * i / (n - 1);
+    ok &= check_grid("Siatka nieregularna t^2", squares);
+
+    std::cout << (ok ? "Wszystkie testy zaliczone" : "Niektore testy nie przeszly") << "\n";
+    return ok ? 0 : 1;
+}
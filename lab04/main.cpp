@@ -6,69 +6,106 @@
 #include <iomanip>
 #include <algorithm>
 #include <string>
+#include <chrono>
+#include <functional>
+#include <random>
+#include "../common/matrix.h"
+#include "../common/simd_kernels.h"
+#include "../common/banded.h"
+#include "../common/thread_pool.h"
+#include "../common/verify.h"
+#include "../common/batched_solver.h"
+#include "trace.h"
 
 using namespace std;
 
-// Funkcja wypisująca macierz rozszerzoną [A | b]
-void printAugmentedMatrix(const vector<vector<double>> &A, const vector<double> &b, ofstream &outFile) {
-    int N = b.size();
-    for (int i = 0; i < N; i++) {
-        for (int j = 0; j < N; j++) {
-            outFile << setw(10) << A[i][j] << " ";
-        }
-        outFile << " | " << setw(10) << b[i] << endl;
-    }
-    outFile << endl;
-}
-
 // Funkcja do eliminacji Gaussa z częściowym pivotingiem
-void gaussElimination(vector<vector<double>> &A, vector<double> &b, int N, ofstream &outFile) {
+void gaussElimination(Matrix &A, vector<double> &b, int N, ofstream &outFile, TraceSink &trace) {
+    vector<double *> rows;
+    vector<double> factors;
     for (int k = 0; k < N; k++) {
         int maxRow = k;
-        double maxVal = fabs(A[k][k]);
+        double maxVal = fabs(A(k, k));
         for (int i = k + 1; i < N; i++) {
-            if (fabs(A[i][k]) > maxVal) {
-                maxVal = fabs(A[i][k]);
+            if (fabs(A(i, k)) > maxVal) {
+                maxVal = fabs(A(i, k));
                 maxRow = i;
             }
         }
-        if (fabs(A[maxRow][k]) < 1e-9) {
+        if (fabs(A(maxRow, k)) < 1e-9) {
             outFile << "Brak unikalnego rozwiązania, macierz może być osobliwa." << endl;
+            trace.summary(N, true);
             return;
         }
         if (maxRow != k) {
-            swap(A[k], A[maxRow]);
+            A.swap_rows(k, maxRow); // zamiana w wektorze permutacji, bez kopiowania wiersza
             swap(b[k], b[maxRow]);
         }
 
+        // najpierw mnożniki wszystkich wierszy, potem jedna aktualizacja
+        // wektorowa, która czyta wiersz główny raz na kilka wierszy
+        const double *pivotRow = A.row(k);
+        rows.clear();
+        factors.clear();
         for (int i = k + 1; i < N; i++) {
-            double factor = A[i][k] / A[k][k];
-            for (int j = k; j < N; j++) {
-                A[i][j] -= factor * A[k][j];
-            }
+            double *row = A.row(i);
+            double factor = row[k] / pivotRow[k];
+            rows.push_back(row + k);
+            factors.push_back(factor);
             b[i] -= factor * b[k];
         }
+        axpy_rows(rows.data(), factors.data(), rows.size(), pivotRow + k, N - k);
+
+        trace.step(k, maxRow, pivotRow[k], A, b);
+    }
+    trace.summary(N, false);
+}
 
-        outFile << "Po eliminacji dla zmiennej x" << k + 1 << ":" << endl;
-        printAugmentedMatrix(A, b, outFile);
+// Rozwiązanie z wykorzystaniem struktury macierzy: trójdiagonalna
+// diagonalnie dominująca -> algorytm Thomasa O(N), wąskie pasmo -> LU
+// pasmowy O(N p (p + q)). A i b zostają bez zmian. Zwraca false, gdy
+// pasmo jest za szerokie (albo macierz osobliwa) i trzeba użyć
+// zwykłej eliminacji.
+bool solveStructured(const Matrix &A, const vector<double> &b, int N, vector<double> &x, TraceSink &trace) {
+    Bandwidth bw = matrix_bandwidth(A);
+    if (bw.tridiagonal() && N > 1) {
+        Tridiagonal T = Tridiagonal::from_matrix(A);
+        if (T.diagonally_dominant()) {
+            x = b;
+            if (thomas_solve(T, x)) {
+                trace.structured(N, bw.lower, bw.upper, "algorytm Thomasa");
+                return true;
+            }
+        }
+    }
+    if (!bw.worth_banded(N)) {
+        return false;
     }
+    BandedLU lu(A, bw);
+    if (lu.singular()) {
+        return false;
+    }
+    x = lu.solve(b);
+    trace.structured(N, bw.lower, bw.upper, "LU pasmowy");
+    return true;
 }
 
 // Funkcja do podstawiania wstecznego
-vector<double> backSubstitution(const vector<vector<double>> &A, const vector<double> &b, int N) {
+vector<double> backSubstitution(const Matrix &A, const vector<double> &b, int N) {
     vector<double> x(N, 0.0);
     for (int i = N - 1; i >= 0; i--) {
+        const double *row = A.row(i);
         double sum = 0.0;
         for (int j = i + 1; j < N; j++) {
-            sum += A[i][j] * x[j];
+            sum += row[j] * x[j];
         }
-        x[i] = (b[i] - sum) / A[i][i];
+        x[i] = (b[i] - sum) / row[i];
     }
     return x;
 }
 
 // Funkcja do wczytywania danych
-bool loadData(const string &filename, vector<vector<double>> &A, vector<double> &b, int &N) {
+bool loadData(const string &filename, Matrix &A, vector<double> &b, int &N) {
     ifstream infile(filename);
     if (!infile) {
         cout << "Nie mozna otworzyc pliku " << filename << endl;
@@ -94,12 +131,12 @@ bool loadData(const string &filename, vector<vector<double>> &A, vector<double>
             continue;
         }
         if (line.find("A:") != string::npos) {
-            A.resize(N, vector<double>(N, 0.0));
+            A.resize(N, N);
             for (int i = 0; i < N; i++) {
                 getline(infile, line);
                 stringstream ss(line);
                 for (int j = 0; j < N; j++) {
-                    ss >> A[i][j];
+                    ss >> A(i, j);
                 }
             }
             break;
@@ -109,13 +146,229 @@ bool loadData(const string &filename, vector<vector<double>> &A, vector<double>
     return true;
 }
 
+// Czas jednego wywołania f w sekundach; powtarzamy, aż uzbiera się ~0.2 s
+double timePerCall(const function<void()> &f) {
+    int reps = 1;
+    for (;;) {
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < reps; r++) {
+            f();
+        }
+        double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (t > 0.2) {
+            return t / reps;
+        }
+        reps *= 2;
+    }
+}
+
+// Mikrobenchmarki jąder z simd_kernels.h dla każdego poziomu SIMD, który
+// obsługuje procesor; wynik w GFLOP/s (2 operacje na element)
+void benchmarkKernels() {
+    mt19937 gen(4);
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+    auto randomVector = [&](size_t n) {
+        vector<double> v(n);
+        for (double &el : v) el = dist(gen);
+        return v;
+    };
+    int maxLevel = simd_kernel_level();
+    cout << "Wykryty poziom SIMD: " << simd_kernel_name(maxLevel) << endl;
+    cout << fixed << setprecision(2);
+
+    cout << "\naxpy: y -= a * x" << endl;
+    for (size_t n : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 22}) {
+        vector<double> x = randomVector(n), y = randomVector(n);
+        cout << "  n = " << setw(8) << n << ":";
+        for (int level = 0; level <= maxLevel; level++) {
+            // bardzo mały mnożnik, żeby y nie urosło przez powtórzenia
+            auto kernel = level == 2 ? axpy_avx512 : level == 1 ? axpy_avx2 : axpy_scalar;
+            double t = timePerCall([&] { kernel(y.data(), x.data(), 1e-9, n); });
+            cout << "  " << simd_kernel_name(level) << " " << 2.0 * n / t / 1e9;
+        }
+        cout << endl;
+    }
+
+    cout << "\naxpy_rows: 64 wiersze naraz vs 64 osobne axpy" << endl;
+    for (size_t n : {size_t(1) << 8, size_t(1) << 12, size_t(1) << 15}) {
+        const size_t m = 64;
+        vector<double> x = randomVector(n), a(m, 1e-9), data = randomVector(m * n);
+        vector<double *> rows(m);
+        for (size_t r = 0; r < m; r++) rows[r] = data.data() + r * n;
+        cout << "  n = " << setw(8) << n << ":";
+        for (int level = 0; level <= maxLevel; level++) {
+            auto single = level == 2 ? axpy_avx512 : level == 1 ? axpy_avx2 : axpy_scalar;
+            auto multi = level == 2 ? axpy_rows_avx512 : level == 1 ? axpy_rows_avx2 : axpy_rows_scalar;
+            double tSingle = timePerCall([&] {
+                for (size_t r = 0; r < m; r++) single(rows[r], x.data(), a[r], n);
+            });
+            double tMulti = timePerCall([&] { multi(rows.data(), a.data(), m, x.data(), n); });
+            cout << "  " << simd_kernel_name(level) << " " << 2.0 * m * n / tSingle / 1e9
+                 << " -> " << 2.0 * m * n / tMulti / 1e9;
+        }
+        cout << endl;
+    }
+
+    cout << "\nrank_k_update: Y(m x n) -= A(m x k) * U(k x n)" << endl;
+    for (size_t k : {size_t(16), size_t(64), size_t(128)}) {
+        const size_t m = 512, n = 256;
+        vector<double> A = randomVector(m * k), U = randomVector(k * n), Y = randomVector(m * n);
+        for (double &el : A) el *= 1e-9;
+        cout << "  m = " << m << ", n = " << n << ", k = " << setw(3) << k << ":";
+        for (int level = 0; level <= maxLevel; level++) {
+            auto kernel = level == 2 ? rank_k_update_avx512 : level == 1 ? rank_k_update_avx2 : rank_k_update_scalar;
+            double t = timePerCall([&] { kernel(m, n, k, A.data(), k, U.data(), n, Y.data(), n); });
+            cout << "  " << simd_kernel_name(level) << " " << 2.0 * m * n * k / t / 1e9;
+        }
+        cout << endl;
+    }
+}
+
+// Długi losowy układ trójdiagonalny diagonalnie dominujący (np. krok
+// niejawnej metody dla równania ciepła): algorytm Thomasa vs wersja
+// równoległa dla rosnącej liczby wątków
+void benchmarkTridiagonal(size_t N) {
+    mt19937 gen(5);
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+    Tridiagonal T{vector<double>(N), vector<double>(N), vector<double>(N)};
+    vector<double> b(N);
+    for (size_t i = 0; i < N; i++) {
+        T.sub[i] = i > 0 ? dist(gen) : 0.0;
+        T.sup[i] = i + 1 < N ? dist(gen) : 0.0;
+        T.diag[i] = 2.0 + fabs(T.sub[i]) + fabs(T.sup[i]);
+        b[i] = dist(gen);
+    }
+    auto maxResidual = [&](const vector<double> &x) {
+        vector<double> r;
+        T.residual(x, b, r);
+        double m = 0.0;
+        for (double e : r) m = max(m, fabs(e));
+        return m;
+    };
+
+    cout << "Uklad trojdiagonalny, N = " << N << endl;
+    vector<double> x;
+    double tThomas = timePerCall([&] {
+        x = b;
+        thomas_solve(T, x);
+    });
+    cout << scientific << setprecision(3);
+    cout << "  Thomas:            " << tThomas << " s, residuum " << maxResidual(x) << endl;
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+    for (unsigned threads = 2; threads <= maxThreads; threads *= 2) {
+        WorkStealingPool pool(threads);
+        double t = timePerCall([&] {
+            x = b;
+            tridiagonal_solve_parallel(T, x, pool);
+        });
+        cout << "  rownolegle, " << setw(2) << threads << " w.: " << t << " s (x" << fixed << setprecision(2)
+             << tThomas / t << scientific << setprecision(3) << "), residuum " << maxResidual(x) << endl;
+    }
+}
+
+// Wiele małych niezależnych układów (rozmiar jak w zadaniach, N = 7 i 12):
+// po kolei gaussElimination + backSubstitution vs BatchedSystems na jednym
+// wątku i na wszystkich; wynik w układach na sekundę
+void benchmarkBatched(size_t count) {
+    mt19937 gen(6);
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+    WorkStealingPool pool(maxThreads);
+    ofstream discard;
+    TraceSink trace(discard, TraceLevel::Off);
+    cout << "Poziom SIMD: " << simd_kernel_name(simd_kernel_level()) << ", ukladow: " << count << endl;
+
+    for (int N : {7, 12}) {
+        vector<Matrix> matrices(count, Matrix(N, N));
+        vector<vector<double>> rhs(count, vector<double>(N));
+        BatchedSystems batch(N, count);
+        for (size_t s = 0; s < count; s++) {
+            for (int i = 0; i < N; i++) {
+                for (int j = 0; j < N; j++) {
+                    matrices[s](i, j) = dist(gen);
+                }
+                rhs[s][i] = dist(gen);
+            }
+            batch.set_system(s, matrices[s], rhs[s]);
+        }
+
+        vector<vector<double>> x(count);
+        auto start = chrono::steady_clock::now();
+        for (size_t s = 0; s < count; s++) {
+            Matrix A = matrices[s];
+            vector<double> b = rhs[s];
+            gaussElimination(A, b, N, discard, trace);
+            x[s] = backSubstitution(A, b, N);
+        }
+        double tSequential = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        // solve() nadpisuje układy, więc każdy pomiar na świeżej kopii
+        BatchedSystems single = batch;
+        start = chrono::steady_clock::now();
+        single.solve();
+        double tSingle = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        BatchedSystems parallel = batch;
+        start = chrono::steady_clock::now();
+        size_t singular = parallel.solve(&pool);
+        double tParallel = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        double maxDiff = 0.0;
+        for (size_t s = 0; s < count; s++) {
+            for (int i = 0; i < N; i++) {
+                maxDiff = max(maxDiff, fabs(parallel.x(s, i) - x[s][i]) / (1.0 + fabs(x[s][i])));
+            }
+        }
+
+        cout << "N = " << setw(2) << N << ": " << scientific << setprecision(2)
+             << "po kolei " << count / tSequential << " ukl/s, wsadowo 1 w. " << count / tSingle
+             << " ukl/s, wsadowo " << maxThreads << " w. " << count / tParallel << " ukl/s" << fixed
+             << setprecision(1) << " (x" << tSequential / tParallel << "), roznica " << scientific
+             << setprecision(1) << maxDiff << ", osobliwych " << singular << defaultfloat << endl;
+    }
+}
+
 int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        benchmarkKernels();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--tridiag") {
+        benchmarkTridiagonal(argc > 2 ? stoul(argv[2]) : size_t(1) << 24);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        benchmarkBatched(argc > 2 ? stoul(argv[2]) : 100000);
+        return 0;
+    }
     if (argc < 2) {
-        cout << "Uzycie: " << argv[0] << " plik_wejsciowy.txt" << endl;
+        cout << "Uzycie: " << argv[0] << " plik_wejsciowy.txt [--trace=off|summary|step|full]"
+             << " [--snapshot=plik.bin] [--dense] | --bench | --tridiag [N] | --batch [liczba]" << endl;
         return 1;
     }
 
-    vector<vector<double>> A;
+    // domyślnie pełny zapis kroków, jak dotąd
+    TraceLevel traceLevel = TraceLevel::Full;
+    string snapshotPath;
+    bool forceDense = false;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--dense") {
+            forceDense = true;
+            continue;
+        }
+        if (arg.rfind("--trace=", 0) == 0 && parseTraceLevel(arg.substr(8), traceLevel)) {
+            continue;
+        }
+        if (arg.rfind("--snapshot=", 0) == 0) {
+            snapshotPath = arg.substr(11);
+            continue;
+        }
+        cout << "Nieznana opcja: " << arg << endl;
+        return 1;
+    }
+
+    Matrix A;
     vector<double> b;
     int N = 0;
 
@@ -124,13 +377,20 @@ int main(int argc, char* argv[]) {
     }
 
     ofstream outFile("wyniki.txt");
+    TraceSink trace(outFile, traceLevel, snapshotPath);
 
-    outFile << "Macierz rozszerzona początkowa:" << endl;
-    printAugmentedMatrix(A, b, outFile);
+    // eliminacja nadpisuje A i b, a sprawdzenie wyniku potrzebuje oryginałów
+    const Matrix originalA = A;
+    const vector<double> originalB = b;
 
-    gaussElimination(A, b, N, outFile);
-
-    vector<double> x = backSubstitution(A, b, N);
+    // macierze pasmowe bez eliminacji gęstej O(N^3); --dense wymusza
+    // zwykłą eliminację (np. żeby zobaczyć wszystkie kroki)
+    vector<double> x;
+    if (forceDense || !solveStructured(A, b, N, x, trace)) {
+        trace.initial(A, b);
+        gaussElimination(A, b, N, outFile, trace);
+        x = backSubstitution(A, b, N);
+    }
 
     outFile << "Rozwiązanie układu:" << endl;
     for (int i = 0; i < N; i++) {
@@ -139,12 +399,16 @@ int main(int argc, char* argv[]) {
 
     outFile << "Sprawdzenie rozwiązania (Ax):" << endl;
     for (int i = 0; i < N; i++) {
+        const double *row = originalA.row(i);
         double sum = 0.0;
         for (int j = 0; j < N; j++) {
-            sum += A[i][j] * x[j];
+            sum += row[j] * x[j];
         }
-        outFile << "Wiersz " << i + 1 << ": " << sum << " (oryginalne b: " << b[i] << ")" << endl;
+        outFile << "Wiersz " << i + 1 << ": " << sum << " (oryginalne b: " << originalB[i] << ")" << endl;
     }
+    BackwardError error = backward_error(originalA, x, originalB);
+    outFile << "Błąd wsteczny: normowy " << error.normwise << ", składowy " << error.componentwise
+            << (error.acceptable(N) ? " (OK)" : " (za duży)") << endl;
 
     outFile.close();
     return 0;
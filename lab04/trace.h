@@ -0,0 +1,131 @@
+#ifndef LAB04_TRACE_H
+#define LAB04_TRACE_H
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "../common/matrix.h"
+
+// Poziomy śledzenia eliminacji Gaussa:
+//   Off     - nic poza wynikiem,
+//   Summary - jedno podsumowanie po eliminacji,
+//   Step    - jedna linia na krok (wiersz i element główny),
+//   Full    - cała macierz rozszerzona po każdym kroku (O(N^3) tekstu).
+enum class TraceLevel { Off = 0, Summary = 1, Step = 2, Full = 3 };
+
+// Najwyższy poziom wkompilowany w program. -DLAB04_TRACE_MAX_LEVEL=0 usuwa
+// całe śledzenie (łącznie ze zrzutami binarnymi) już na etapie kompilacji.
+#ifndef LAB04_TRACE_MAX_LEVEL
+#define LAB04_TRACE_MAX_LEVEL 3
+#endif
+
+constexpr TraceLevel TRACE_MAX_LEVEL = static_cast<TraceLevel>(LAB04_TRACE_MAX_LEVEL);
+
+// Funkcja wypisująca macierz rozszerzoną [A | b]
+inline void printAugmentedMatrix(const Matrix &A, const std::vector<double> &b, std::ostream &out) {
+    int N = b.size();
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            out << std::setw(10) << A(i, j) << " ";
+        }
+        out << " | " << std::setw(10) << b[i] << std::endl;
+    }
+    out << std::endl;
+}
+
+// Odbiorca śledzenia. Każde wywołanie jest szablonem z poziomem jako
+// parametrem, więc powyżej TRACE_MAX_LEVEL znika w całości, a poniżej
+// kosztuje jedno porównanie na krok eliminacji.
+//
+// Zrzut binarny (opcjonalny) to ciąg rekordów:
+//   "GEL1", uint32 N, uint32 krok (0 = stan początkowy),
+//   N*N double macierzy A w kolejności wierszy po zamianach, N double b.
+class TraceSink {
+public:
+    TraceSink(std::ostream &out, TraceLevel level, const std::string &snapshotPath = "")
+        : out_(out), level_(level) {
+        if (TRACE_MAX_LEVEL > TraceLevel::Off && !snapshotPath.empty()) {
+            snapshot_.open(snapshotPath, std::ios::binary);
+        }
+    }
+
+    template <TraceLevel L>
+    bool enabled() const {
+        if constexpr (L > TRACE_MAX_LEVEL) {
+            return false;
+        } else {
+            return level_ >= L;
+        }
+    }
+
+    // Stan przed eliminacją
+    void initial(const Matrix &A, const std::vector<double> &b) {
+        if (enabled<TraceLevel::Full>()) {
+            out_ << "Macierz rozszerzona początkowa:" << std::endl;
+            printAugmentedMatrix(A, b, out_);
+        }
+        snapshot(A, b, 0);
+    }
+
+    // Po wyeliminowaniu zmiennej x(k+1) z wierszem głównym pivotRow
+    void step(int k, int pivotRow, double pivot, const Matrix &A, const std::vector<double> &b) {
+        if (pivotRow != k) swaps_++;
+        if (enabled<TraceLevel::Full>()) {
+            out_ << "Po eliminacji dla zmiennej x" << k + 1 << ":" << std::endl;
+            printAugmentedMatrix(A, b, out_);
+        } else if (enabled<TraceLevel::Step>()) {
+            out_ << "Krok " << k + 1 << ": wiersz główny " << pivotRow + 1
+                 << ", element główny " << pivot << std::endl;
+        }
+        snapshot(A, b, k + 1);
+    }
+
+    // Rozwiązanie z pominięciem eliminacji gęstej (macierz pasmowa)
+    void structured(int N, size_t lower, size_t upper, const char *method) {
+        if (enabled<TraceLevel::Summary>()) {
+            out_ << "Macierz pasmowa: N = " << N << ", pod przekątną " << lower << ", nad przekątną " << upper
+                 << ", metoda: " << method << std::endl;
+        }
+    }
+
+    void summary(int N, bool singular) {
+        if (enabled<TraceLevel::Summary>()) {
+            out_ << "Eliminacja: N = " << N << ", zamian wierszy: " << swaps_
+                 << (singular ? ", przerwana (macierz osobliwa)" : "") << std::endl;
+        }
+    }
+
+private:
+    void snapshot(const Matrix &A, const std::vector<double> &b, int step) {
+        if constexpr (TRACE_MAX_LEVEL > TraceLevel::Off) {
+            if (!snapshot_.is_open()) return;
+            const std::uint32_t header[2] = {static_cast<std::uint32_t>(b.size()), static_cast<std::uint32_t>(step)};
+            snapshot_.write("GEL1", 4);
+            snapshot_.write(reinterpret_cast<const char *>(header), sizeof(header));
+            for (size_t i = 0; i < b.size(); i++) {
+                snapshot_.write(reinterpret_cast<const char *>(A.row(i)), b.size() * sizeof(double));
+            }
+            snapshot_.write(reinterpret_cast<const char *>(b.data()), b.size() * sizeof(double));
+        }
+    }
+
+    std::ostream &out_;
+    TraceLevel level_;
+    std::ofstream snapshot_;
+    int swaps_ = 0;
+};
+
+// "off" / "summary" / "step" / "full"; false dla nieznanej nazwy
+inline bool parseTraceLevel(const std::string &name, TraceLevel &level) {
+    if (name == "off") level = TraceLevel::Off;
+    else if (name == "summary") level = TraceLevel::Summary;
+    else if (name == "step") level = TraceLevel::Step;
+    else if (name == "full") level = TraceLevel::Full;
+    else return false;
+    return true;
+}
+
+#endif
@@ -203,11 +203,21 @@
 #include <vector>
 #include <sstream>
 #include <string>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+#include "../common/matrix.h"
+#include "../common/lu.h"
+#include "../common/tiled_lu.h"
+#include "../common/mixed_lu.h"
+#include "../common/verify.h"
 
 using namespace std;
 
 // Funkcja do wczytywania danych z pliku
-void wczytaj_dane(const string& nazwa_pliku, int& N, vector<double>& b, vector<vector<double>>& A) {
+void wczytaj_dane(const string& nazwa_pliku, int& N, vector<double>& b, Matrix& A) {
     ifstream plik(nazwa_pliku);
     string linia;
 
@@ -234,142 +244,240 @@ void wczytaj_dane(const string& nazwa_pliku, int& N, vector<double>& b, vector<v
     cout << endl;
 
     // Wczytanie macierzy A
-    A.resize(N, vector<double>(N));
+    A.resize(N, N);
     for (int i = 0; i < N; ++i) {
         if (getline(plik, linia)) {
             stringstream ss(linia);
             double temp;
             for (int j = 0; j < N; ++j) {
                 ss >> temp;
-                A[i][j] = temp;
+                A(i, j) = temp;
             }
         }
     }
 
     cout << "Macierz A: " << endl;
-    for (const auto& row : A) {
-        for (const auto& el : row) {
-            cout << el << " ";
+    for (int i = 0; i < N; ++i) {
+        for (int j = 0; j < N; ++j) {
+            cout << A(i, j) << " ";
         }
         cout << endl;
     }
 }
 
-// Rozkład LU
-void rozklad_LU(vector<vector<double>>& A, vector<vector<double>>& L, vector<vector<double>>& U) {
-    int N = A.size();
-    L.resize(N, vector<double>(N, 0));
-    U.resize(N, vector<double>(N, 0));
+// Funkcja do wypisania macierzy
+void wypisz_macierz(const Matrix& M) {
+    for (size_t i = 0; i < M.rows(); ++i) {
+        for (size_t j = 0; j < M.cols(); ++j) {
+            cout << M(i, j) << " ";
+        }
+        cout << endl;
+    }
+}
 
+// Funkcja do obliczania A * x
+void oblicz_Ax(const Matrix& A, const vector<double>& x, vector<double>& result) {
+    int N = A.rows();
+    result.resize(N);
     for (int i = 0; i < N; ++i) {
-        L[i][i] = 1.0;
+        const double* Ai = A.row(i);
+        result[i] = 0;
+        for (int j = 0; j < N; ++j) {
+            result[i] += Ai[j] * x[j];
+        }
     }
+}
 
-    for (int k = 0; k < N; ++k) {
-        for (int j = k; j < N; ++j) {
-            U[k][j] = A[k][j];
-            for (int r = 0; r < k; ++r) {
-                U[k][j] -= L[k][r] * U[r][j];
+// Pomiar wielowątkowego rozkładu LU dla N od 500 do max_N: GFLOP/s
+// (2/3 N^3 operacji) i efektywność skalowania silnego t(1) / (p * t(p))
+void benchmark_LU(int max_N) {
+    unsigned max_threads = max(1u, thread::hardware_concurrency());
+    vector<unsigned> watki;
+    for (unsigned p = 1; p < max_threads; p *= 2) {
+        watki.push_back(p);
+    }
+    watki.push_back(max_threads);
+
+    mt19937 gen(2025);
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    cout << setw(7) << "N" << setw(9) << "watki" << setw(12) << "czas [s]"
+         << setw(11) << "GFLOP/s" << setw(14) << "efektywnosc" << setw(13) << "residuum" << endl;
+    for (int N : {500, 1000, 2000, 5000, 10000, 20000}) {
+        if (N > max_N) break;
+        Matrix A(N, N);
+        for (int i = 0; i < N; ++i) {
+            double* Ai = A.row(i);
+            for (int j = 0; j < N; ++j) {
+                Ai[j] = dist(gen);
             }
         }
-
-        for (int i = k + 1; i < N; ++i) {
-            L[i][k] = A[i][k];
-            for (int r = 0; r < k; ++r) {
-                L[i][k] -= L[i][r] * U[r][k];
-            }
-            L[i][k] /= U[k][k];
+        vector<double> b(N);
+        for (double& el : b) {
+            el = dist(gen);
         }
-    }
-}
 
-// Rozwiązywanie układu równań Lz = b
-void rozwiaz_Lz(const vector<vector<double>>& L, const vector<double>& b, vector<double>& z) {
-    int N = L.size();
-    z.resize(N);
+        double t1 = 0.0;
+        for (unsigned p : watki) {
+            WorkStealingPool pula(p);
+            Matrix kopia = A;
+            auto start = chrono::steady_clock::now();
+            LUFactorization lu = lu_factorize_parallel(std::move(kopia), pula);
+            double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            if (p == 1) t1 = t;
+
+            // względne residuum ||Ax - b|| / (||A|| ||x||) w normie maksimum
+            vector<double> x = lu.solve(b), Ax;
+            oblicz_Ax(A, x, Ax);
+            double r = 0.0, normA = 0.0, normx = 0.0;
+            for (int i = 0; i < N; ++i) {
+                double wiersz = 0.0;
+                for (int j = 0; j < N; ++j) {
+                    wiersz += abs(A(i, j));
+                }
+                normA = max(normA, wiersz);
+                normx = max(normx, abs(x[i]));
+                r = max(r, abs(Ax[i] - b[i]));
+            }
 
-    for (int i = 0; i < N; ++i) {
-        z[i] = b[i];
-        for (int j = 0; j < i; ++j) {
-            z[i] -= L[i][j] * z[j];
+            cout << setw(7) << N << setw(9) << p << setw(12) << fixed << setprecision(3) << t
+                 << setw(11) << setprecision(2) << 2.0 / 3.0 * N * double(N) * N / t / 1e9
+                 << setw(14) << setprecision(2) << t1 / (p * t)
+                 << setw(13) << scientific << setprecision(1) << r / (normA * normx) << defaultfloat << endl;
         }
     }
 }
 
-// Rozwiązywanie układu równań Ux = z
-void rozwiaz_Ux(const vector<vector<double>>& U, const vector<double>& z, vector<double>& x) {
-    int N = U.size();
-    x.resize(N);
+// Rozkład w mieszanej precyzji (float + doszlifowanie w double) w porównaniu
+// ze zwykłym LU w double: czas rozkładu i rozwiązania, liczba poprawek
+// i względne residuum. Macierz "prawie osobliwa" (ostatni wiersz prawie
+// równy przedostatniemu, cond ~ 1e10) jest za źle uwarunkowana na float
+// i powinna przejść na rozkład w double.
+void benchmark_mieszana(int max_N) {
+    mt19937 gen(2026);
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+
+    cout << setw(7) << "N" << setw(17) << "macierz" << setw(13) << "double [s]" << setw(14) << "mieszana [s]"
+         << setw(10) << "poprawki" << setw(9) << "tryb" << setw(17) << "residuum double" << setw(19)
+         << "residuum mieszana" << endl;
+    for (int N : {500, 1000, 2000, 4000, 8000}) {
+        if (N > max_N) break;
+        for (bool prawie_osobliwa : {false, true}) {
+            Matrix A(N, N);
+            for (int i = 0; i < N; ++i) {
+                double* Ai = A.row(i);
+                for (int j = 0; j < N; ++j) {
+                    Ai[j] = dist(gen);
+                }
+            }
+            if (prawie_osobliwa) {
+                for (int j = 0; j < N; ++j) {
+                    A(N - 1, j) = A(N - 2, j) + 1e-10 * dist(gen);
+                }
+            }
+            vector<double> b(N);
+            for (double& el : b) {
+                el = dist(gen);
+            }
 
-    for (int i = N - 1; i >= 0; --i) {
-        x[i] = z[i];
-        for (int j = i + 1; j < N; ++j) {
-            x[i] -= U[i][j] * x[j];
-        }
-        x[i] /= U[i][i];
-    }
-}
+            auto start = chrono::steady_clock::now();
+            LUFactorization lu(A);
+            vector<double> x = lu.solve(b);
+            double t_double = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            start = chrono::steady_clock::now();
+            MixedPrecisionLU mieszana(A);
+            RefinementInfo info;
+            vector<double> y = mieszana.solve(b, &info);
+            double t_mieszana = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            // względne residuum rozwiązania z LU w double, liczone tak samo
+            vector<double> Ax;
+            oblicz_Ax(A, x, Ax);
+            double r = 0.0, normA = 0.0, normx = 0.0;
+            for (int i = 0; i < N; ++i) {
+                double wiersz = 0.0;
+                for (int j = 0; j < N; ++j) {
+                    wiersz += abs(A(i, j));
+                }
+                normA = max(normA, wiersz);
+                normx = max(normx, abs(x[i]));
+                r = max(r, abs(Ax[i] - b[i]));
+            }
 
-// Funkcja do wypisania macierzy
-void wypisz_macierz(const vector<vector<double>>& M) {
-    for (const auto& wiersz : M) {
-        for (double el : wiersz) {
-            cout << el << " ";
+            cout << setw(7) << N << setw(17) << (prawie_osobliwa ? "prawie osobliwa" : "losowa")
+                 << setw(13) << fixed << setprecision(3) << t_double << setw(14) << t_mieszana
+                 << setw(10) << info.iterations << setw(9) << (info.fallback ? "double" : "float")
+                 << setw(17) << scientific << setprecision(1) << r / (normA * normx)
+                 << setw(19) << info.backward_error << defaultfloat << endl;
         }
-        cout << endl;
     }
 }
 
-// Funkcja do obliczania A * x
-void oblicz_Ax(const vector<vector<double>>& A, const vector<double>& x, vector<double>& result) {
-    int N = A.size();
-    result.resize(N);
-    for (int i = 0; i < N; ++i) {
-        result[i] = 0;
-        for (int j = 0; j < N; ++j) {
-            result[i] += A[i][j] * x[j];
-        }
+int main(int argc, char* argv[]) {
+    // lab05 --bench [max_N]: pomiar wydajności zamiast zadania z pliku
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        benchmark_LU(argc > 2 ? stoi(argv[2]) : 20000);
+        return 0;
+    }
+    // lab05 --mixed [max_N]: LU w mieszanej precyzji vs LU w double
+    if (argc > 1 && string(argv[1]) == "--mixed") {
+        benchmark_mieszana(argc > 2 ? stoi(argv[2]) : 8000);
+        return 0;
     }
-}
 
-// Funkcja do obliczania L * U
-void oblicz_LU(const vector<vector<double>>& L, const vector<vector<double>>& U, vector<vector<double>>& result) {
-    int N = L.size();
-    result.resize(N, vector<double>(N, 0));
-    for (int i = 0; i < N; ++i) {
-        for (int j = 0; j < N; ++j) {
-            for (int k = 0; k < N; ++k) {
-                result[i][j] += L[i][k] * U[k][j];
+    // --confidence=p: pewność testu L * U = P * A (domyślnie 1 - 1e-6)
+    VerificationOptions weryfikacja;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("--confidence=", 0) == 0) {
+            string wartosc = arg.substr(13);
+            size_t przeczytane = 0;
+            double p = 0.0;
+            try {
+                p = stod(wartosc, &przeczytane);
+            } catch (const exception&) {
+                przeczytane = 0;
+            }
+            if (przeczytane == 0 || przeczytane != wartosc.size() || !(p > 0.0 && p < 1.0)) {
+                cout << "Niepoprawna wartosc " << arg << ": pewnosc musi byc liczba z przedzialu (0, 1)" << endl;
+                cout << "Uzycie: " << argv[0] << " [--confidence=p] | --bench [max_N] | --mixed [max_N]" << endl;
+                return 1;
             }
+            weryfikacja.confidence = p;
         }
     }
-}
 
-int main() {
     int N;
     vector<double> b;
-    vector<vector<double>> A;
+    Matrix A;
 
     // Wczytanie danych z pliku
     wczytaj_dane("LU_gr3_2.txt", N, b, A);
 
-    // Rozkład LU
-    vector<vector<double>> L, U;
-    rozklad_LU(A, L, U);
+    // Rozkład PA = LU z częściowym wyborem elementu głównego; A zostaje
+    // skopiowana, bo jest potrzebna niżej do sprawdzenia wyników
+    LUFactorization lu(A);
+    if (lu.singular()) {
+        cout << "Macierz A jest osobliwa, rozkład LU nie istnieje." << endl;
+        return 1;
+    }
+    Matrix L = lu.lower(), U = lu.upper();
+    vector<size_t> P = lu.permutation();
 
     // Wypisanie macierzy L i U
     cout << "Macierz L:" << endl;
     wypisz_macierz(L);
     cout << "Macierz U:" << endl;
     wypisz_macierz(U);
+    cout << "Permutacja wierszy P:" << endl;
+    for (size_t p : P) {
+        cout << p << " ";
+    }
+    cout << endl;
 
-    // Rozwiązywanie układu równań Lz = b
-    vector<double> z;
-    rozwiaz_Lz(L, b, z);
-
-    // Rozwiązywanie układu równań Ux = z
-    vector<double> x;
-    rozwiaz_Ux(U, z, x);
+    // Rozwiązanie Ly = Pb i Ux = y; rozkład można użyć dla kolejnych wektorów b
+    vector<double> x = lu.solve(b);
 
     // Wypisanie wyników
     cout << "Rozwiązanie x:" << endl;
@@ -386,15 +494,17 @@ int main() {
         cout << "b[" << i << "] = " << b[i] << ", Ax[" << i << "] = " << Ax[i] << endl;
     }
 
-    // Sprawdzanie poprawności L * U = A
-    vector<vector<double>> LU;
-    oblicz_LU(L, U, LU);
-    cout << "\nSprawdzanie poprawności (L * U = A):" << endl;
-    for (int i = 0; i < N; ++i) {
-        for (int j = 0; j < N; ++j) {
-            cout << "A[" << i << "][" << j << "] = " << A[i][j] << ", LU[" << i << "][" << j << "] = " << LU[i][j] << endl;
-        }
-    }
+    BackwardError blad = backward_error(A, x, b);
+    cout << "Błąd wsteczny: normowy " << blad.normwise << ", składowy " << blad.componentwise
+         << (blad.acceptable(N) ? " (OK)" : " (za duży)") << endl;
+
+    // Sprawdzanie poprawności L * U = P * A testem Freivaldsa: kilka mnożeń
+    // przez losowy wektor, O(N^2) zamiast O(N^3) mnożenia L * U
+    VerificationResult wynik = verify_lu(A, lu, weryfikacja);
+    cout << "\nSprawdzanie poprawności (L * U = P * A), test losowy:" << endl;
+    cout << "Prób: " << wynik.trials << ", pewność: " << wynik.confidence
+         << ", max |LUr - PAr| / tolerancja: " << wynik.max_ratio
+         << (wynik.passed ? " (OK)" : " (BŁĄD)") << endl;
 
     return 0;
 }
@@ -6,105 +6,87 @@
 #include <iomanip>
 #include <string>
 #include <cstdlib>
+#include "../common/polynomial.h"
 using namespace std;
-// Funkcja do obliczania wartości wielomianu za pomocą schematu Hornera
-double horner(const vector<double>& a, double x) {
-    double result = a[0];
-    for (size_t i = 1; i < a.size(); ++i) {
-        result = result * x + a[i];
-    }
-    return result;
-}
-
 // Funkcja do obliczania wartości funkcji x*cos^3(x)
 double func_xcos3x(double x) {
     return x * pow(cos(x), 3);
 }
 
 // Metoda prostokątów
-double rectangle_method(const vector<double>& a, double a_range, double b_range, int n) {
+template <typename F>
+double rectangle_rule(const F& f, double a_range, double b_range, int n) {
     double h = (b_range - a_range) / n;
     double sum = 0.0;
     
     for (int i = 0; i < n; ++i) {
         double x = a_range + (i + 0.5) * h; // Środek prostokąta
-        sum += horner(a, x);
-    }
-    
-    return h * sum;
-}
-
-// Metoda prostokątów dla funkcji x*cos^3(x)
-double rectangle_method_xcos3x(double a_range, double b_range, int n) {
-    double h = (b_range - a_range) / n;
-    double sum = 0.0;
-    
-    for (int i = 0; i < n; ++i) {
-        double x = a_range + (i + 0.5) * h; // Środek prostokąta
-        sum += func_xcos3x(x);
+        sum += f(x);
     }
     
     return h * sum;
 }
 
 // Metoda trapezów
-double trapezoid_method(const vector<double>& a, double a_range, double b_range, int n) {
-    double h = (b_range - a_range) / n;
-    double sum = 0.5 * (horner(a, a_range) + horner(a, b_range));
-    
-    for (int i = 1; i < n; ++i) {
-        double x = a_range + i * h;
-        sum += horner(a, x);
-    }
-    
-    return h * sum;
-}
-
-// Metoda trapezów dla funkcji x*cos^3(x)
-double trapezoid_method_xcos3x(double a_range, double b_range, int n) {
+template <typename F>
+double trapezoid_rule(const F& f, double a_range, double b_range, int n) {
     double h = (b_range - a_range) / n;
-    double sum = 0.5 * (func_xcos3x(a_range) + func_xcos3x(b_range));
+    double sum = 0.5 * (f(a_range) + f(b_range));
     
     for (int i = 1; i < n; ++i) {
         double x = a_range + i * h;
-        sum += func_xcos3x(x);
+        sum += f(x);
     }
     
     return h * sum;
 }
 
 // Metoda Simpsona
-double simpson_method(const vector<double>& a, double a_range, double b_range, int n) {
+template <typename F>
+double simpson_rule(const F& f, double a_range, double b_range, int n) {
     if (n % 2 != 0) {
         n++; // n musi być parzyste dla metody Simpsona
     }
     
     double h = (b_range - a_range) / n;
-    double sum = horner(a, a_range) + horner(a, b_range);
+    double sum = f(a_range) + f(b_range);
     
     for (int i = 1; i < n; ++i) {
         double x = a_range + i * h;
-        sum += horner(a, x) * (i % 2 == 0 ? 2 : 4);
+        sum += f(x) * (i % 2 == 0 ? 2 : 4);
     }
     
     return h * sum / 3.0;
 }
 
+// Metoda prostokątów dla wielomianu
+double rectangle_method(const vector<double>& a, double a_range, double b_range, int n) {
+    return with_polynomial(Polynomial::from_descending(a), [&](const auto& p) { return rectangle_rule(p, a_range, b_range, n); });
+}
+
+// Metoda prostokątów dla funkcji x*cos^3(x)
+double rectangle_method_xcos3x(double a_range, double b_range, int n) {
+    return rectangle_rule(func_xcos3x, a_range, b_range, n);
+}
+
+// Metoda trapezów dla wielomianu
+double trapezoid_method(const vector<double>& a, double a_range, double b_range, int n) {
+    return with_polynomial(Polynomial::from_descending(a), [&](const auto& p) { return trapezoid_rule(p, a_range, b_range, n); });
+}
+
+// Metoda trapezów dla funkcji x*cos^3(x)
+double trapezoid_method_xcos3x(double a_range, double b_range, int n) {
+    return trapezoid_rule(func_xcos3x, a_range, b_range, n);
+}
+
+// Metoda Simpsona dla wielomianu
+double simpson_method(const vector<double>& a, double a_range, double b_range, int n) {
+    return with_polynomial(Polynomial::from_descending(a), [&](const auto& p) { return simpson_rule(p, a_range, b_range, n); });
+}
+
 // Metoda Simpsona dla funkcji x*cos^3(x)
 double simpson_method_xcos3x(double a_range, double b_range, int n) {
-    if (n % 2 != 0) {
-        n++; // n musi być parzyste dla metody Simpsona
-    }
-    
-    double h = (b_range - a_range) / n;
-    double sum = func_xcos3x(a_range) + func_xcos3x(b_range);
-    
-    for (int i = 1; i < n; ++i) {
-        double x = a_range + i * h;
-        sum += func_xcos3x(x) * (i % 2 == 0 ? 2 : 4);
-    }
-    
-    return h * sum / 3.0;
+    return simpson_rule(func_xcos3x, a_range, b_range, n);
 }
 
 // Funkcja do testowania zbieżności
@@ -211,8 +193,9 @@ int main() {
     // Uruchom skrypt Pythona do obliczenia dokładnych wartości całek
     run_exact_integration();
     
-    // Odczytaj dokładne wartości z plików wygenerowanych przez Pythona
-    double exact_poly = read_exact_value("exact_poly.txt");
+    // Całka wielomianu liczona dokładnie z funkcji pierwotnej, całka
+    // x*cos^3(x) odczytana z pliku wygenerowanego przez Pythona
+    double exact_poly = Polynomial::from_descending(a).integrate(a_range, b_range);
     double exact_xcos3x = read_exact_value("exact_xcos3x.txt");
     
     cout << "Dokładna wartość całki wielomianu: " << exact_poly << endl;
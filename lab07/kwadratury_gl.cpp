@@ -7,18 +7,10 @@
 #include <string>
 #include <cstdlib>
 #include <functional>
+#include "../common/polynomial.h"
 
 using namespace std;
 
-// Funkcja do obliczania wartości wielomianu za pomocą schematu Hornera
-double horner(const vector<double>& a, double x) {
-    double result = a[0];
-    for (size_t i = 1; i < a.size(); ++i) {
-        result = result * x + a[i];
-    }
-    return result;
-}
-
 // Funkcja do obliczania wartości funkcji x^2*sin^3(x)
 double func_x_sin3x(double x) {
     double sin_x = sin(x);
@@ -48,7 +40,8 @@ double func_xcos3x(double x) {
 // ====================== Metody z poprzednich zajęć ======================
 
 // Metoda prostokątów
-double rectangle_method(function<double(double)> f, double a_range, double b_range, int n) {
+template <typename F>
+double rectangle_method(const F& f, double a_range, double b_range, int n) {
     double h = (b_range - a_range) / n;
     double sum = 0.0;
     
@@ -61,7 +54,8 @@ double rectangle_method(function<double(double)> f, double a_range, double b_ran
 }
 
 // Metoda trapezów
-double trapezoid_method(function<double(double)> f, double a_range, double b_range, int n) {
+template <typename F>
+double trapezoid_method(const F& f, double a_range, double b_range, int n) {
     double h = (b_range - a_range) / n;
     double sum = 0.5 * (f(a_range) + f(b_range));
     
@@ -74,7 +68,8 @@ double trapezoid_method(function<double(double)> f, double a_range, double b_ran
 }
 
 // Metoda Simpsona
-double simpson_method(function<double(double)> f, double a_range, double b_range, int n) {
+template <typename F>
+double simpson_method(const F& f, double a_range, double b_range, int n) {
     if (n % 2 != 0) {
         n++; // n musi być parzyste dla metody Simpsona
     }
@@ -157,7 +152,8 @@ double map_to_ab(double x, double a, double b) {
 }
 
 // Kwadratura Gaussa-Legendre'a
-double gauss_legendre_quadrature(function<double(double)> f, double a, double b, int n) {
+template <typename F>
+double gauss_legendre_quadrature(const F& f, double a, double b, int n) {
     // Pobierz węzły i wagi
     vector<GLNode> nodes = get_gl_nodes_and_weights(n);
     
@@ -187,7 +183,8 @@ double gauss_legendre_quadrature(function<double(double)> f, double a, double b,
 }
 
 // Adaptacyjna kwadratura Gaussa-Legendre'a dla oscylacyjnych funkcji
-double adaptive_gauss_legendre(function<double(double)> f, double a, double b, int n) {
+template <typename F>
+double adaptive_gauss_legendre(const F& f, double a, double b, int n) {
     // Oszacuj ilość potrzebnych podprzedziałów na podstawie długości przedziału
     // i typu funkcji - dla funkcji oscylacyjnych potrzeba więcej podprzedziałów
     
@@ -208,7 +205,8 @@ double adaptive_gauss_legendre(function<double(double)> f, double a, double b, i
 }
 
 // Adaptacyjna kwadratura Gaussa-Legendre'a dla funkcji o szybkim wzroście
-double adaptive_exp_gauss_legendre(function<double(double)> f, double a, double b, int n) {
+template <typename F>
+double adaptive_exp_gauss_legendre(const F& f, double a, double b, int n) {
     // Dla funkcji wykładniczych podział na wzrastająco gęste przedziały
     if (b <= a) return 0.0;
     
@@ -299,7 +297,8 @@ void test_gl_convergence(function<double(double)> f, double a_range, double b_ra
 }
 
 // Funkcja porównująca metody całkowania
-void compare_integration_methods(function<double(double)> f, double a_range, double b_range, 
+template <typename F>
+void compare_integration_methods(const F& f, double a_range, double b_range, 
                                  double exact_value, int n, const string& filename, const string& func_name) {
     cout << "Porównanie metod całkowania dla " << func_name << " w przedziale [" 
          << a_range << ", " << b_range << "]" << endl;
@@ -450,14 +449,12 @@ int main() {
     data_file >> poly_a >> poly_b;
     data_file.close();
     
-    // Funkcja wielomianowa za pomocą lambdy
-    auto poly_func = [&poly_coeffs](double x) {
-        return horner(poly_coeffs, x);
-    };
-    
-    // Porównanie metod dla wielomianu
-    compare_integration_methods(poly_func, poly_a, poly_b, exact_poly, 1000, 
-                               "comparison_poly.txt", "wielomianu");
+    // Porównanie metod dla wielomianu; stopień z pliku wybiera wersję
+    // z rozwiniętym schematem Hornera (jak w lab06)
+    with_polynomial(Polynomial::from_descending(poly_coeffs), [&](const auto& poly_func) {
+        compare_integration_methods(poly_func, poly_a, poly_b, exact_poly, 1000, 
+                                   "comparison_poly.txt", "wielomianu");
+    });
     cout << endl;
     
     // Porównanie metod dla funkcji x*cos^3(x)
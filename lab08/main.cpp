@@ -5,64 +5,28 @@
 #include <fstream>
 #include <chrono>
 #include <algorithm>
+#include "../common/function_table.h"
+#include "../common/polynomial.h"
+#include "../common/matrix.h"
+#include "../common/lu.h"
+#include "../common/cholesky.h"
 using namespace std;
 // Function to approximate: f(x) = e^x · cos(6x) - x^3 + 5x^2 - 10
 double f(double x) {
     return exp(x) * cos(6 * x) - pow(x, 3) + 5 * pow(x, 2) - 10;
 }
 
-// Function to evaluate a polynomial using Horner's method
-double evaluatePolynomial(const vector<double>& coefficients, double x) {
-    double result = coefficients[0];
-    for (size_t i = 1; i < coefficients.size(); ++i) {
-        result = result * x + coefficients[i];
+// Function to solve a system of linear equations in place: b is replaced
+// by the solution and A by its factors, so nothing is copied. Symmetric
+// matrices (the normal equations always are) go to Cholesky, with a pivoted
+// LDL^T fallback once rounding makes them numerically indefinite; anything
+// else goes to LU with partial pivoting. Returns the name of the method used.
+const char* solveLinearSystem(Matrix& A, vector<double>& b) {
+    if (is_symmetric(A)) {
+        return symmetric_solver_name(solve_symmetric_in_place(A, b));
     }
-    return result;
-}
-
-// Function to solve a system of linear equations using Gaussian elimination
-vector<double> solveLinearSystem(vector<vector<double>> A, vector<double> b) {
-    int n = A.size();
-    
-    // Forward elimination with partial pivoting
-    for (int i = 0; i < n; i++) {
-        // Find pivot row
-        int maxRow = i;
-        double maxVal = abs(A[i][i]);
-        for (int j = i + 1; j < n; j++) {
-            if (abs(A[j][i]) > maxVal) {
-                maxVal = abs(A[j][i]);
-                maxRow = j;
-            }
-        }
-        
-        // Swap rows if needed
-        if (maxRow != i) {
-            swap(A[i], A[maxRow]);
-            swap(b[i], b[maxRow]);
-        }
-        
-        // Eliminate below
-        for (int j = i + 1; j < n; j++) {
-            double factor = A[j][i] / A[i][i];
-            b[j] -= factor * b[i];
-            for (int k = i; k < n; k++) {
-                A[j][k] -= factor * A[i][k];
-            }
-        }
-    }
-    
-    // Back substitution
-    vector<double> x(n);
-    for (int i = n - 1; i >= 0; i--) {
-        x[i] = b[i];
-        for (int j = i + 1; j < n; j++) {
-            x[i] -= A[i][j] * x[j];
-        }
-        x[i] /= A[i][i];
-    }
-    
-    return x;
+    LUFactorization(std::move(A)).solve_in_place(b);
+    return "LU";
 }
 
 // Function to calculate the inner product of two monomials integrated over [a,b]
@@ -74,7 +38,8 @@ double innerProductMonomials(int i, int j, double a, double b) {
 }
 
 // Function to calculate the inner product of a monomial with the function f(x)
-double innerProductWithFunction(int i, double a, double b, int numPoints) {
+// (f is read from a precomputed table instead of calling exp/cos every time)
+double innerProductWithFunction(int i, double a, double b, int numPoints, const FunctionTable& fTable) {
     // We'll use a numerical integration method (trapezoidal rule) for this
     double h = (b - a) / numPoints;
     double sum = 0;
@@ -82,52 +47,50 @@ double innerProductWithFunction(int i, double a, double b, int numPoints) {
     for (int j = 0; j <= numPoints; j++) {
         double x = a + j * h;
         double weight = (j == 0 || j == numPoints) ? 0.5 : 1.0;
-        sum += weight * pow(x, i) * f(x);
+        sum += weight * pow(x, i) * fTable(x);
     }
     
     return sum * h;
 }
 
-// Function to perform least squares approximation
-vector<double> leastSquaresApproximation(double a, double b, int degree, int numPoints) {
+// Function to perform least squares approximation; solver receives the
+// name of the method that solved the normal equations
+Polynomial leastSquaresApproximation(double a, double b, int degree, int numPoints, const FunctionTable& fTable,
+                                     const char*& solver) {
     int n = degree + 1;
-    vector<vector<double>> A(n, vector<double>(n));
+    Matrix A(n, n);
     vector<double> B(n);
     
     // Fill matrix A and vector B 
     for (int i = 0; i < n; i++) {
         for (int j = 0; j < n; j++) {
             // A[i][j] is the inner product of x^i and x^j
-            A[i][j] = innerProductMonomials(i, j, a, b);
+            A(i, j) = innerProductMonomials(i, j, a, b);
         }
         // B[i] is the inner product of x^i and f(x)
-        B[i] = innerProductWithFunction(i, a, b, numPoints);
+        B[i] = innerProductWithFunction(i, a, b, numPoints, fTable);
     }
     
-    // Solve the linear system
-    vector<double> coefficients = solveLinearSystem(A, B);
-    
-    // The coefficients from the linear solver are in reversed order for the standard polynomial form
-    // For a polynomial a0 + a1*x + a2*x^2 + ... + an*x^n, we want to return [an, ..., a2, a1, a0]
-    reverse(coefficients.begin(), coefficients.end());
-    
-    return coefficients;
+    // Solve the linear system; the solution is a0, a1, ..., an, which is
+    // exactly the Polynomial coefficient order
+    solver = solveLinearSystem(A, B);
+    return Polynomial::from_ascending(B);
 }
 
 // Function to calculate the approximation error at a specific point
-double approximationError(const vector<double>& coefficients, double x) {
-    double approx = evaluatePolynomial(coefficients, x);
+double approximationError(const Polynomial& approximation, double x) {
+    double approx = approximation(x);
     return f(x) - approx;
 }
 
 // Function to calculate the root mean square error
-double calculateRMSE(const vector<double>& coefficients, double a, double b, int numPoints) {
+double calculateRMSE(const Polynomial& approximation, double a, double b, int numPoints) {
     double h = (b - a) / numPoints;
     double sumSquaredErrors = 0;
     
     for (int i = 0; i <= numPoints; i++) {
         double x = a + i * h;
-        double error = approximationError(coefficients, x);
+        double error = approximationError(approximation, x);
         sumSquaredErrors += error * error;
     }
     
@@ -135,7 +98,7 @@ double calculateRMSE(const vector<double>& coefficients, double a, double b, int
 }
 
 // Function to save data points to a file for plotting
-void saveDataForPlotting(const vector<double>& coefficients, double a, double b, 
+void saveDataForPlotting(const Polynomial& approximation, double a, double b, 
                         int numPoints, const string& filename) {
     ofstream outFile(filename);
     double h = (b - a) / numPoints;
@@ -145,7 +108,7 @@ void saveDataForPlotting(const vector<double>& coefficients, double a, double b,
     for (int i = 0; i <= numPoints; i++) {
         double x = a + i * h;
         double exactValue = f(x);
-        double approxValue = evaluatePolynomial(coefficients, x);
+        double approxValue = approximation(x);
         double error = exactValue - approxValue;
         
         outFile << x << "\t" << exactValue << "\t" << approxValue << "\t" << error << "\n";
@@ -166,32 +129,40 @@ int main() {
     
     cout << "Least Squares Approximation for f(x) = e^x · cos(6x) - x^3 + 5x^2 - 10\n";
     cout << "Over interval [" << a << ", " << b << "]\n\n";
+
+    // Tabulate f once; the error bound is far below the quadrature error
+    FunctionTable fTable(f, a, b, 1e-12);
+    if (!fTable.meets_bound()) {
+        cerr << "Warning: table for f reached only error " << fTable.max_error() << "\n";
+    }
     
     for (int degree : degrees) {
         auto start = chrono::high_resolution_clock::now();
         
         // Calculate approximation coefficients
-        vector<double> coefficients = leastSquaresApproximation(a, b, degree, numPoints);
+        const char* solver = "";
+        Polynomial approximation = leastSquaresApproximation(a, b, degree, numPoints, fTable, solver);
         
         auto end = chrono::high_resolution_clock::now();
         chrono::duration<double, milli> duration = end - start;
         
         // Calculate RMSE
-        double rmse = calculateRMSE(coefficients, a, b, numPoints);
+        double rmse = calculateRMSE(approximation, a, b, numPoints);
         errors.push_back(rmse);
         
         // Print results
         cout << "Polynomial degree: " << degree << "\n";
         cout << "Coefficients (standard form a0 + a1*x + a2*x^2 + ... + an*x^n):\n";
-        for (int i = 0; i < coefficients.size(); i++) {
-            cout << "  a" << i << " = " << setprecision(8) << coefficients[coefficients.size() - 1 - i] << "\n";
+        for (size_t i = 0; i < approximation.size(); i++) {
+            cout << "  a" << i << " = " << setprecision(8) << approximation[i] << "\n";
         }
         cout << "RMSE: " << setprecision(8) << rmse << "\n";
+        cout << "Solver: " << solver << "\n";
         cout << "Computation time: " << duration.count() << " ms\n\n";
         
         // Save data for degree 6 (as specified in the assignment)
         if (degree == 6) {
-            saveDataForPlotting(coefficients, a, b, numPoints, "approximation_data.txt");
+            saveDataForPlotting(approximation, a, b, numPoints, "approximation_data.txt");
         }
     }
     
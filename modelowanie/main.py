@@ -3,61 +3,46 @@ import matplotlib.pyplot as plt
 from matplotlib import cm
 import matplotlib.ticker as ticker
 
-# Dane z tabeli
-methods = ["Jacobi", "Gauss-Seidel", "GMRES", "GMRES+Jacobi", "GMRES+GS", "GMRES+ILU(0)"]
-convergent = ["NIE", "TAK", "NIE", "NIE", "TAK", "TAK"]
-max_norms = [6.65e+23, 1.9e-6, 1068.769, 3.41e+18, 0.005622, 0.000599]
-iterations = [100, 100, 100, 100, 100, 13]
-red_norms = [1.545396, 0.800983, 0.85074, 1.247147, 0.38859, 0.11504]
-times = [0.082684, 0.019541, 0.01049, 0.007068, 0.008741, 0.00983]
+# Dane z programu solvers.cpp (./solvers plik.txt zapisuje oba pliki CSV)
+import csv
 
-# Tworzenie sztucznych danych dla przebiegu zbieżności normy w kolejnych iteracjach
-n_iterations = max(iterations)
-convergence_data = {}
+methods, convergent, max_norms, iterations, red_norms, times = [], [], [], [], [], []
+with open("wyniki_metod.csv", newline="") as f:
+    for row in csv.DictReader(f):
+        methods.append(row["metoda"])
+        convergent.append(row["zbiezna"])
+        max_norms.append(float(row["norma_koncowa"]))
+        iterations.append(int(row["iteracje"]))
+        red_norms.append(float(row["redukcja"]))
+        times.append(float(row["czas_s"]))
 
-for i, method in enumerate(methods):
-    if convergent[i] == "TAK":
-        # Dla zbieżnych metod - wykładniczy spadek normy
-        if method == "GMRES+ILU(0)":
-            # Specjalny przypadek dla metody, która zbiegła w 13 iteracjach
-            temp_data = np.geomspace(1, max_norms[i], 13)
-            convergence_data[method] = np.pad(temp_data[::-1], (0, n_iterations-13), 'constant', constant_values=max_norms[i])
-        else:
-            # Pozostałe zbieżne metody
-            convergence_data[method] = np.geomspace(1, max_norms[i], n_iterations)[::-1]
-    else:
-        # Dla niezbieżnych metod - różne scenariusze
-        if method == "Jacobi":
-            # Rosnąca wykładniczo
-            convergence_data[method] = np.geomspace(1, max_norms[i], n_iterations)
-        elif method == "GMRES":
-            # Oscylująca z tendencją rosnącą
-            base = np.linspace(1, max_norms[i], n_iterations)
-            noise = np.sin(np.linspace(0, 20*np.pi, n_iterations)) * max_norms[i] * 0.1
-            convergence_data[method] = base + noise
-        else:
-            # Początkowo malejąca, potem rosnąca
-            half = n_iterations // 2
-            first_half = np.geomspace(1, 1e-3, half)[::-1]
-            second_half = np.geomspace(1e-3, max_norms[i], n_iterations - half)
-            convergence_data[method] = np.concatenate([first_half, second_half])
+# Przebieg normy residuum w kolejnych iteracjach (puste pola po zakończeniu metody)
+convergence_data = {method: [] for method in methods}
+with open("residua.csv", newline="") as f:
+    for row in csv.DictReader(f):
+        for method in methods:
+            if row[method] != "":
+                convergence_data[method].append(float(row[method]))
 
 # Tworzenie wykresu
 plt.figure(figsize=(12, 7))
 cmap = cm.get_cmap('viridis', len(methods))
 
 for i, method in enumerate(methods):
-    plt.semilogy(range(1, n_iterations+1), convergence_data[method], 
+    plt.semilogy(range(len(convergence_data[method])), convergence_data[method],
                  label=f"{method} ({'zbieżna' if convergent[i]=='TAK' else 'niezbieżna'})",
                  color=cmap(i), linewidth=2)
 
-# Dodanie pionowej linii dla GMRES+ILU(0), która zbiegła w 13 iteracjach
-plt.axvline(x=13, color='red', linestyle='--', alpha=0.5, 
-            label="GMRES+ILU(0) zbiegła po 13 iteracjach")
+# Pionowa linia dla najszybciej zbieżnej metody
+converged_iterations = [(iterations[i], methods[i]) for i in range(len(methods)) if convergent[i] == "TAK"]
+if converged_iterations:
+    best_iterations, best_method = min(converged_iterations)
+    plt.axvline(x=best_iterations, color='red', linestyle='--', alpha=0.5,
+                label=f"{best_method} zbiegła po {best_iterations} iteracjach")
 
-plt.title('Symulacja przebiegu normy błędu w zależności od iteracji', fontsize=14)
+plt.title('Przebieg normy residuum w zależności od iteracji', fontsize=14)
 plt.xlabel('Iteracja', fontsize=12)
-plt.ylabel('Norma błędu (skala logarytmiczna)', fontsize=12)
+plt.ylabel('Norma residuum ||b - Ax|| (skala logarytmiczna)', fontsize=12)
 plt.grid(True, which="both", ls="--", alpha=0.7)
 plt.legend(fontsize=10, loc='upper center', bbox_to_anchor=(0.5, -0.15), ncol=2)
 plt.tight_layout()
@@ -98,8 +83,4 @@ for bar in bars:
             ha='center', va='bottom', rotation=90, fontsize=9)
 
 plt.tight_layout()
-plt.show()
-
-# UWAGA: Ten kod generuje symulowane dane zbieżności, ponieważ nie mamy
-# rzeczywistych danych dla każdej iteracji. Prawdziwy wykres powinien
-# być oparty na faktycznych wartościach normy zapisanych podczas obliczeń.
\ No newline at end of file
+plt.show()
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include "../common/matrix.h"
+#include "../common/csr.h"
+#include "../common/iterative.h"
+#include "../common/sparse_lu.h"
+
+using namespace std;
+
+// Porównanie metod iteracyjnych: Jacobi, Gauss-Seidel, GMRES oraz GMRES
+// z prekondycjonowaniem Jacobi / GS / ILU(0), a jako odniesienie rzadki
+// rozkład LU (bez i z uporządkowaniem RCM). Wynik trafia do dwóch plików
+// czytanych przez main.py:
+//   wyniki_metod.csv - tabela (zbieżność, końcowa norma, iteracje, średni
+//                      współczynnik redukcji normy na iterację, czas),
+//   residua.csv      - ||b - Ax||_2 po każdej iteracji dla każdej metody.
+//
+// Uzycie: solvers plik.txt [max_iteracji] [tolerancja]
+//         solvers --poisson k [max_iteracji] [tolerancja]
+// Plik może być w formacie z lab04 ("N = ...", "b:", "A:") albo z lab05
+// (N, wiersz b, N wierszy A).
+
+// Wczytanie układu z pliku w formacie lab04 albo lab05
+bool wczytaj_uklad(const string& nazwa_pliku, Matrix& A, vector<double>& b) {
+    ifstream plik(nazwa_pliku);
+    if (!plik) {
+        cout << "Nie mozna otworzyc pliku " << nazwa_pliku << endl;
+        return false;
+    }
+    string linia;
+    if (!getline(plik, linia)) return false;
+
+    // Nagłówek: "N = ..." (lab04) albo sama liczba N (lab05)
+    bool format_lab04 = linia.find("N") != string::npos;
+    stringstream naglowek(format_lab04 ? linia.substr(linia.find("=") + 1) : linia);
+    int N = 0;
+    if (!(naglowek >> N) || N <= 0) {
+        cout << "Niepoprawny format pliku " << nazwa_pliku << endl;
+        return false;
+    }
+
+    if (format_lab04) {
+        while (getline(plik, linia)) {
+            if (linia.find("b:") != string::npos) {
+                getline(plik, linia);
+                stringstream ss(linia);
+                double v;
+                while (ss >> v) b.push_back(v);
+            } else if (linia.find("A:") != string::npos) {
+                break;
+            }
+        }
+    } else {
+        getline(plik, linia);
+        stringstream ss(linia);
+        double v;
+        while (ss >> v) b.push_back(v);
+    }
+
+    A.resize(N, N);
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            plik >> A(i, j);
+        }
+    }
+    if (!plik || (int)b.size() != N) {
+        cout << "Niepoprawny format pliku " << nazwa_pliku << endl;
+        return false;
+    }
+    return true;
+}
+
+// Odczyt liczby dodatniej z argumentu; cały napis musi być liczbą
+template <typename T>
+bool czytaj_dodatnia(const char* tekst, T& wartosc) {
+    stringstream ss(tekst);
+    T v{};
+    if (!(ss >> v) || !(ss >> ws).eof() || !(v > 0)) return false;
+    wartosc = v;
+    return true;
+}
+
+struct WynikMetody {
+    string nazwa;
+    IterativeResult wynik;
+    double norma_maks;  // ||b - Ax||_inf po zakończeniu
+};
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cout << "Uzycie: " << argv[0] << " plik.txt | --poisson k [max_iteracji] [tolerancja]" << endl;
+        return 1;
+    }
+
+    CsrMatrix A;
+    vector<double> b;
+    int arg = 2;
+    if (string(argv[1]) == "--poisson") {
+        if (argc < 3) {
+            cout << "Brak rozmiaru siatki po --poisson" << endl;
+            return 1;
+        }
+        long long k = 0;
+        if (!czytaj_dodatnia(argv[2], k)) {
+            cout << "Niepoprawny rozmiar siatki " << argv[2] << " (oczekiwano liczby dodatniej)" << endl;
+            return 1;
+        }
+        A = CsrMatrix::poisson2d(static_cast<size_t>(k));
+        b.assign(A.n, 1.0);
+        arg = 3;
+    } else {
+        Matrix gesta;
+        if (!wczytaj_uklad(argv[1], gesta, b)) return 1;
+        A = CsrMatrix::from_dense(gesta);
+    }
+
+    IterativeOptions opcje;
+    if (argc > arg && !czytaj_dodatnia(argv[arg], opcje.max_iterations)) {
+        cout << "Niepoprawna liczba iteracji " << argv[arg] << " (oczekiwano liczby dodatniej)" << endl;
+        return 1;
+    }
+    if (argc > arg + 1 && !czytaj_dodatnia(argv[arg + 1], opcje.tolerance)) {
+        cout << "Niepoprawna tolerancja " << argv[arg + 1] << " (oczekiwano liczby dodatniej)" << endl;
+        return 1;
+    }
+
+    cout << "N = " << A.n << ", niezerowych: " << A.nonzeros()
+         << ", max iteracji: " << opcje.max_iterations << ", tolerancja: " << opcje.tolerance << endl;
+
+    vector<WynikMetody> wyniki;
+    auto uruchom = [&](const string& nazwa, auto metoda) {
+        try {
+            IterativeResult w = metoda();
+            vector<double> r;
+            A.residual(w.x, b, r);
+            double norma = 0.0;
+            for (double e : r) norma = max(norma, abs(e));
+            wyniki.push_back({nazwa, w, norma});
+        } catch (const exception& e) {
+            cout << nazwa << ": " << e.what() << endl;
+        }
+    };
+    uruchom("Jacobi", [&] { return jacobi(A, b, opcje); });
+    uruchom("Gauss-Seidel", [&] { return gauss_seidel(A, b, opcje); });
+    for (Preconditioner p : {Preconditioner::None, Preconditioner::Jacobi,
+                             Preconditioner::GaussSeidel, Preconditioner::ILU0}) {
+        string nazwa = p == Preconditioner::None ? "GMRES" : string("GMRES+") + preconditioner_name(p);
+        uruchom(nazwa, [&] { return gmres(A, b, p, opcje); });
+    }
+
+    // Tabela: średni współczynnik redukcji normy to (r_k / r_0)^(1/k)
+    ofstream tabela("wyniki_metod.csv");
+    tabela << "metoda,zbiezna,norma_koncowa,iteracje,redukcja,czas_s" << endl;
+    cout << left << setw(16) << "Metoda" << setw(9) << "Zbiezna" << setw(15) << "Norma maks."
+         << setw(10) << "Iteracje" << setw(11) << "Redukcja" << "Czas [s]" << endl;
+    for (const WynikMetody& m : wyniki) {
+        const vector<double>& h = m.wynik.residuals;
+        double redukcja = m.wynik.iterations > 0 && h.front() > 0.0
+                              ? pow(h.back() / h.front(), 1.0 / m.wynik.iterations)
+                              : 0.0;
+        const char* zbiezna = m.wynik.converged ? "TAK" : "NIE";
+        tabela << m.nazwa << "," << zbiezna << "," << setprecision(6) << m.norma_maks << ","
+               << m.wynik.iterations << "," << redukcja << "," << m.wynik.seconds << endl;
+        cout << left << setw(16) << m.nazwa << setw(9) << zbiezna << setw(15) << setprecision(4) << m.norma_maks
+             << setw(10) << m.wynik.iterations << setw(11) << redukcja << m.wynik.seconds << endl;
+    }
+
+    // Rzadki rozkład LU: analiza, rozkład, ponowny rozkład z gotowym wzorcem
+    // (ta sama macierz, więc mierzy sam zysk z pominięcia analizy i wyboru
+    // elementu głównego) oraz rozwiązanie
+    cout << endl << left << setw(12) << "LU rzadki" << setw(12) << "nnz(L+U)" << setw(11) << "Analiza"
+         << setw(11) << "Rozklad" << setw(11) << "Ponowny" << setw(11) << "Rozw." << "Norma maks." << endl;
+    for (SparseOrdering uporzadkowanie : {SparseOrdering::Natural, SparseOrdering::RCM}) {
+        auto czas = [](auto t0) { return chrono::duration<double>(chrono::steady_clock::now() - t0).count(); };
+        auto t0 = chrono::steady_clock::now();
+        SparseSymbolic analiza = sparse_lu_analyze(A, uporzadkowanie);
+        double t_analiza = czas(t0);
+        t0 = chrono::steady_clock::now();
+        SparseLU lu(A, move(analiza));
+        double t_rozklad = czas(t0);
+        if (lu.singular()) {
+            cout << sparse_ordering_name(uporzadkowanie) << ": macierz osobliwa" << endl;
+            continue;
+        }
+        t0 = chrono::steady_clock::now();
+        lu.refactor(A);
+        double t_ponowny = czas(t0);
+        t0 = chrono::steady_clock::now();
+        vector<double> x = lu.solve(b), r;
+        double t_rozw = czas(t0);
+        A.residual(x, b, r);
+        double norma = 0.0;
+        for (double e : r) norma = max(norma, abs(e));
+        cout << left << setw(12) << sparse_ordering_name(uporzadkowanie) << setw(12)
+             << lu.nonzeros_L() + lu.nonzeros_U() - A.n << setprecision(4) << setw(11) << t_analiza
+             << setw(11) << t_rozklad << setw(11) << t_ponowny << setw(11) << t_rozw << norma << endl;
+    }
+
+    // Przebieg residuów: wiersz = iteracja, kolumna = metoda; puste pola po
+    // zakończeniu danej metody
+    ofstream residua("residua.csv");
+    residua << "iteracja";
+    size_t najdluzszy = 0;
+    for (const WynikMetody& m : wyniki) {
+        residua << "," << m.nazwa;
+        najdluzszy = max(najdluzszy, m.wynik.residuals.size());
+    }
+    residua << endl << setprecision(10);
+    for (size_t k = 0; k < najdluzszy; k++) {
+        residua << k;
+        for (const WynikMetody& m : wyniki) {
+            residua << ",";
+            if (k < m.wynik.residuals.size()) residua << m.wynik.residuals[k];
+        }
+        residua << endl;
+    }
+
+    cout << "Zapisano wyniki_metod.csv i residua.csv" << endl;
+    return 0;
+}